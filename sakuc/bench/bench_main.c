@@ -0,0 +1,82 @@
+// 2026-10-19 - benchmark driver, results go to stdout as JSON lines.
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include "common_bench_defs.h"
+#include "multi_pattern_match_bench.h"
+#include "ringbuffer_bench.h"
+#include "spsc_ringbuffer_bench.h"
+#include "mpmc_ringbuffer_bench.h"
+#include "timing_wheel_bench.h"
+#include "deque_bench.h"
+#include "ws_pool_bench.h"
+#include "concurrent_deque_bench.h"
+#include "sliding_window_bench.h"
+
+struct bench_suite {
+    const char *name;
+    int (*run)(const struct bench_options *opt);
+};
+
+static const struct bench_suite suites[] = {
+    { "multi_pattern_match", bench_multi_pattern_match },
+    { "ringbuffer", bench_ringbuffer },
+    { "spsc_ringbuffer", bench_spsc_ringbuffer },
+    { "mpmc_ringbuffer", bench_mpmc_ringbuffer },
+    { "timing_wheel", bench_timing_wheel },
+    { "deque", bench_deque },
+    { "ws_pool", bench_ws_pool },
+    { "concurrent_deque", bench_concurrent_deque },
+    { "sliding_window", bench_sliding_window },
+};
+
+static const size_t num_suites = sizeof(suites) / sizeof(suites[0]);
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--full] [--seed N] [--text-mb N] [suite ...]\n"
+                    "suites:", prog);
+    for (size_t i = 0; i < num_suites; i++)
+        fprintf(stderr, " %s", suites[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[])
+{
+    struct bench_options opt = { .full = FALSE, .seed = 20140315, .text_mb = 0 };
+    const char *selected[sizeof(suites) / sizeof(suites[0])];
+    size_t num_selected = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--full") == 0)
+            opt.full = TRUE;
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            opt.seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--text-mb") == 0 && i + 1 < argc)
+            opt.text_mb = strtoul(argv[++i], nullptr, 0);
+        else if (argv[i][0] != '-' && num_selected < num_suites)
+            selected[num_selected++] = argv[i];
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int failed = 0;
+    for (size_t i = 0; i < num_suites; i++) {
+        int run = (num_selected == 0);
+        for (size_t j = 0; j < num_selected; j++)
+            if (strcmp(selected[j], suites[i].name) == 0)
+                run = TRUE;
+        if (!run)
+            continue;
+
+        if (suites[i].run(&opt) == -1) {
+            fprintf(stderr, "*** FAILED! - %s\n", suites[i].name);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
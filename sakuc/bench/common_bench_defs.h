@@ -0,0 +1,104 @@
+// 2026-10-19 - benchmark helpers shared by all the bench/*.c files.
+
+#ifndef COMMON_BENCH_DEFS_H_
+#define COMMON_BENCH_DEFS_H_
+
+/* Every bench .c file defines _GNU_SOURCE before any include, so clock_gettime()
+   and friends are available even with -std=c99.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include "../src/common_defs.h"
+#include "../src/common_atomic_defs.h"
+
+/* Options shared by all the benchmark suites, filled by bench_main.c */
+struct bench_options {
+    int full;           // run the (slow) full-scale workloads as well.
+    uint64_t seed;      // seed of the workload generator, reproducible runs.
+    size_t text_mb;     // size of the generated input stream (MB), 0 - default.
+};
+
+/* Monotonic wall clock, in nanoseconds. */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/* CPU time consumed by the whole process, in nanoseconds. */
+static inline uint64_t bench_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/* xorshift64* - small and reproducible across platforms, @state must not be 0. */
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+/* spin a little, then give the cpu away (keeps single-core machines usable). */
+#define bench_backoff(spins) do {       \
+    if (++(spins) < 64)                 \
+        osal_cpu_relax();               \
+    else {                              \
+        sched_yield();                  \
+        (spins) = 0;                    \
+    }                                   \
+} while (__LINE__ == -1)
+
+/* Read a "VmXXX:   1234 kB" line of /proc/self/status, 0 returned if unavailable. */
+static inline size_t bench_proc_status_kb(const char *field)
+{
+    FILE *fp = fopen("/proc/self/status", "r");
+    if (!fp)
+        return 0;
+
+    char line[256];
+    size_t kb = 0;
+    size_t field_len = strlen(field);
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, field, field_len) == 0 && line[field_len] == ':') {
+            sscanf(line + field_len + 1, "%zu", &kb);
+            break;
+        }
+    }
+    fclose(fp);
+    return kb;
+}
+
+#define bench_rss_kb()      bench_proc_status_kb("VmRSS")
+#define bench_peak_rss_kb() bench_proc_status_kb("VmHWM")
+
+/* Reset the peak RSS (VmHWM) to the current RSS, best-effort (linux >= 4.0). */
+static inline void bench_reset_peak_rss(void)
+{
+    FILE *fp = fopen("/proc/self/clear_refs", "w");
+    if (!fp)
+        return;
+    fputs("5", fp);
+    fclose(fp);
+}
+
+/* Results are emitted as one JSON object per line on stdout, so that runs can be
+   diffed or loaded by a script; human readable progress goes to stderr.
+
+   eg. bench_emit_begin("mpm"); bench_emit_str("workload", "english");
+       bench_emit_uint("patterns", 1000); bench_emit_end();
+ */
+#define bench_emit_begin(suite)     printf("{\"suite\":\"%s\"", (suite))
+#define bench_emit_str(key, val)    printf(",\"%s\":\"%s\"", (key), (val))
+#define bench_emit_uint(key, val)   printf(",\"%s\":%llu", (key), (unsigned long long) (val))
+#define bench_emit_double(key, val) printf(",\"%s\":%.3f", (key), (double) (val))
+#define bench_emit_end()            do { printf("}\n"); fflush(stdout); } while (__LINE__ == -1)
+
+#endif // COMMON_BENCH_DEFS_H_
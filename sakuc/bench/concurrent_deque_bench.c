@@ -0,0 +1,163 @@
+/* Scaling benchmark of sakuc_cdeque_t (two-lock, unbounded).
+
+    Vary the number of producer and consumer threads, and compare with the same
+    traffic through a sakuc_deque_t protected by one pthread_mutex_t:
+        two_lock          - consumers poll #sakuc_cdeque_pop_front with backoff.
+        two_lock_blocking - consumers sleep in #sakuc_cdeque_pop_front_timed.
+        mutex_deque       - push_back / pop_front of sakuc_deque_t under one lock.
+    
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include "../src/deque.h"
+#include "../src/concurrent_deque.h"
+#include "concurrent_deque_bench.h"
+
+#define BENCH_CDQ_MAX_THREADS 4
+#define BENCH_CDQ_ELEM_SIZE 16
+#define BENCH_CDQ_BLOCK 256
+
+enum bench_cdq_impl {
+    BENCH_CDQ_TWO_LOCK,
+    BENCH_CDQ_TWO_LOCK_BLOCKING,
+    BENCH_CDQ_MUTEX_DEQUE,
+    BENCH_CDQ_NUM_IMPLS,
+};
+
+static const char *bench_cdq_impl_names[] = { "two_lock", "two_lock_blocking", "mutex_deque" };
+
+struct bench_cdq_ctx {
+    enum bench_cdq_impl impl;
+    sakuc_cdeque_t *cdq;
+    struct sakuc_deque *locked_dq;
+    pthread_mutex_t lock;
+    size_t messages_per_producer;
+    size_t num_messages;
+    size_t num_consumed;
+};
+
+static int bench_push(struct bench_cdq_ctx *ctx, const void *msg)
+{
+    if (ctx->impl != BENCH_CDQ_MUTEX_DEQUE)
+        return sakuc_cdeque_push_back(ctx->cdq, msg, BENCH_CDQ_ELEM_SIZE);
+    
+    pthread_mutex_lock(&ctx->lock);
+    int ret = sakuc_deque_push_back(ctx->locked_dq, msg, BENCH_CDQ_ELEM_SIZE);
+    pthread_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+static int bench_pop(struct bench_cdq_ctx *ctx, void *msg)
+{
+    if (ctx->impl == BENCH_CDQ_TWO_LOCK)
+        return sakuc_cdeque_pop_front(ctx->cdq, msg, BENCH_CDQ_ELEM_SIZE);
+    if (ctx->impl == BENCH_CDQ_TWO_LOCK_BLOCKING)
+        // short timeout: the last consumers must notice that everything was consumed.
+        return sakuc_cdeque_pop_front_timed(ctx->cdq, msg, BENCH_CDQ_ELEM_SIZE, 1);
+    
+    pthread_mutex_lock(&ctx->lock);
+    int ret = sakuc_deque_pop_front(ctx->locked_dq, msg, BENCH_CDQ_ELEM_SIZE);
+    pthread_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+static void *producer_thread(void *arg)
+{
+    struct bench_cdq_ctx *ctx = arg;
+    char msg[BENCH_CDQ_ELEM_SIZE] = {0};
+    for (size_t i = 0; i < ctx->messages_per_producer; i++) {
+        *(size_t *)msg = i;
+        if (bench_push(ctx, msg) == -1)
+            break;
+    }
+    return nullptr;
+}
+
+static void *consumer_thread(void *arg)
+{
+    struct bench_cdq_ctx *ctx = arg;
+    char msg[BENCH_CDQ_ELEM_SIZE];
+    int spins = 0;
+    while (osal_atomic_load_relaxed(&ctx->num_consumed) < ctx->num_messages) {
+        if (bench_pop(ctx, msg) == -1) {
+            if (ctx->impl != BENCH_CDQ_TWO_LOCK_BLOCKING)
+                bench_backoff(spins);
+            continue;
+        }
+        spins = 0;
+        osal_atomic_fetch_add(&ctx->num_consumed, 1);
+    }
+    return nullptr;
+}
+
+static int run_case(struct bench_cdq_ctx *ctx, size_t num_producers, size_t num_consumers)
+{
+    pthread_t threads[2 * BENCH_CDQ_MAX_THREADS];
+    size_t num_threads = 0;
+    
+    ctx->messages_per_producer = ctx->num_messages / num_producers;
+    ctx->num_messages = ctx->messages_per_producer * num_producers;
+    ctx->num_consumed = 0;
+    
+    uint64_t t0 = bench_now_ns();
+    uint64_t cpu0 = bench_cpu_ns();
+    for (size_t i = 0; i < num_consumers; i++)
+        if (pthread_create(&threads[num_threads++], nullptr, consumer_thread, ctx) != 0)
+            return -1;
+    for (size_t i = 0; i < num_producers; i++)
+        if (pthread_create(&threads[num_threads++], nullptr, producer_thread, ctx) != 0)
+            return -1;
+    for (size_t i = 0; i < num_threads; i++)
+        pthread_join(threads[i], nullptr);
+    uint64_t ns = bench_now_ns() - t0;
+    uint64_t cpu_ns = bench_cpu_ns() - cpu0;
+    
+    double s = ns ? ns / 1e9 : 1e-9;
+    bench_emit_begin("concurrent_deque");
+    bench_emit_str("impl", bench_cdq_impl_names[ctx->impl]);
+    bench_emit_uint("producers", num_producers);
+    bench_emit_uint("consumers", num_consumers);
+    bench_emit_uint("elem_size", BENCH_CDQ_ELEM_SIZE);
+    bench_emit_uint("messages", ctx->num_messages);
+    bench_emit_double("msgs_s", ctx->num_messages / s);
+    bench_emit_double("cpu_ns_per_msg", (double) cpu_ns / ctx->num_messages);
+    bench_emit_end();
+    return 0;
+}
+
+int bench_concurrent_deque(const struct bench_options *opt)
+{
+    static const size_t num_threads[] = { 1, 2, BENCH_CDQ_MAX_THREADS };
+    static const size_t num_cases = sizeof(num_threads) / sizeof(num_threads[0]);
+    size_t num_messages = opt->full ? 20000000 : 1000000;
+    struct bench_cdq_ctx ctx;
+    
+    ctx.cdq = sakuc_cdeque_new(BENCH_CDQ_BLOCK, BENCH_CDQ_ELEM_SIZE);
+    ctx.locked_dq = sakuc_deque_new(BENCH_CDQ_BLOCK, BENCH_CDQ_ELEM_SIZE,
+                                    SAKUC_DEQUE_SWEEP_IMMEDIATELY);
+    if (!ctx.cdq || !ctx.locked_dq)
+        return -1;
+    pthread_mutex_init(&ctx.lock, nullptr);
+    
+    for (int impl = 0; impl < BENCH_CDQ_NUM_IMPLS; impl++) {
+        ctx.impl = (enum bench_cdq_impl) impl;
+        for (size_t p = 0; p < num_cases; p++) {
+            for (size_t c = 0; c < num_cases; c++) {
+                fprintf(stderr, "concurrent_deque: %s, %zu producers, %zu consumers ...\n",
+                        bench_cdq_impl_names[impl], num_threads[p], num_threads[c]);
+                ctx.num_messages = num_messages;
+                if (run_case(&ctx, num_threads[p], num_threads[c]) == -1)
+                    return -1;
+            }
+        }
+    }
+    
+    pthread_mutex_destroy(&ctx.lock);
+    sakuc_deque_destroy(ctx.locked_dq);
+    sakuc_cdeque_destroy(ctx.cdq);
+    return 0;
+}
@@ -0,0 +1,282 @@
+/* Benchmark of sakuc_deque_t block layouts.
+
+    fill_drain - push_back N elements, then pop_front all of them.
+    steady     - FIFO with a constant backlog, one push_back + one pop_front per op.
+    Reported: ns per element, and how many allocations the blocks needed.
+    
+    impl:
+        two_alloc   - the former layout (header and element buffer allocated
+                      separately, reached through a pointer), kept here as baseline.
+        single_alloc - header and elements in one cache-line-aligned allocation.
+        single_alloc_page - same, SAKUC_DEQUE_PAGE_BLOCKS.
+        typed       - SAKUC_DEQUE_DEFINE deques of size_t and of a 64 bytes struct,
+                      inline with direct assignment (no block allocation count).
+    
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include "../src/deque.h"
+#include "../src/typed_deque.h"
+#include "deque_bench.h"
+
+#define BENCH_DQ_BLOCK 64
+#define BENCH_DQ_MAX_ELEM_SIZE 64
+
+/* ## the former two-allocation layout, push_back/pop_front only, sweep immediately. */
+struct legacy_block {
+    struct legacy_block *next;
+    size_t start, end;
+    void *data_buffer;
+};
+
+struct legacy_deque {
+    struct legacy_block *head, *tail;
+    size_t elem_size;
+    size_t length;
+    size_t allocs;
+};
+
+static struct legacy_block *legacy_block_new(struct legacy_deque *dq)
+{
+    struct legacy_block *b = calloc(1, sizeof(struct legacy_block));
+    void *buf = malloc(BENCH_DQ_BLOCK * dq->elem_size);
+    if (!b || !buf) {
+        free(b); free(buf);
+        return nullptr;
+    }
+    b->data_buffer = buf;
+    dq->allocs += 2;
+    return b;
+}
+
+static int legacy_push_back(struct legacy_deque *dq, const void *data)
+{
+    if (!dq->tail || dq->tail->end == BENCH_DQ_BLOCK) {
+        struct legacy_block *b = legacy_block_new(dq);
+        if (!b)
+            return -1;
+        if (dq->tail)
+            dq->tail->next = b;
+        else
+            dq->head = b;
+        dq->tail = b;
+    }
+    memcpy((char *)dq->tail->data_buffer + dq->tail->end * dq->elem_size, data, dq->elem_size);
+    ++ dq->tail->end;
+    ++ dq->length;
+    return 0;
+}
+
+static int legacy_pop_front(struct legacy_deque *dq, void *data)
+{
+    if (dq->length == 0)
+        return -1;
+    if (dq->head->start == BENCH_DQ_BLOCK) {
+        struct legacy_block *b = dq->head;
+        dq->head = b->next;
+        free(b->data_buffer);
+        free(b);
+    }
+    memcpy(data, (char *)dq->head->data_buffer + dq->head->start * dq->elem_size, dq->elem_size);
+    ++ dq->head->start;
+    -- dq->length;
+    return 0;
+}
+
+static void legacy_destroy(struct legacy_deque *dq)
+{
+    while (dq->head) {
+        struct legacy_block *b = dq->head;
+        dq->head = b->next;
+        free(b->data_buffer);
+        free(b);
+    }
+}
+
+/* ## typed deques, same block size. */
+struct bench_dq_elem64 {
+    size_t value;
+    char payload[BENCH_DQ_MAX_ELEM_SIZE - sizeof(size_t)];
+};
+
+SAKUC_DEQUE_DEFINE(bench_dq8, size_t, BENCH_DQ_BLOCK)
+SAKUC_DEQUE_DEFINE(bench_dq64, struct bench_dq_elem64, BENCH_DQ_BLOCK)
+
+/* the workload of #run_one on the typed deque @name, @value is the size_t within @elem. */
+#define BENCH_DQ_TYPED_RUN(name, elem, value) do {                              \
+    name##_t *dq = name##_new();                                                \
+    if (!dq)                                                                    \
+        return 0;                                                               \
+    t0 = bench_now_ns();                                                        \
+    for (size_t i = 0; i < backlog; i++) {                                      \
+        (value) = i;                                                            \
+        name##_push_back(dq, (elem));                                           \
+    }                                                                           \
+    if (steady) {                                                               \
+        t0 = bench_now_ns();                                                    \
+        for (size_t i = 0; i < n; i++) {                                        \
+            (value) = backlog + i;                                              \
+            name##_push_back(dq, (elem));                                       \
+            name##_pop_front(dq, &(elem));                                      \
+            *checksum += (value);                                               \
+        }                                                                       \
+    }                                                                           \
+    else {                                                                      \
+        for (size_t i = 0; i < n; i++) {                                        \
+            name##_pop_front(dq, &(elem));                                      \
+            *checksum += (value);                                               \
+        }                                                                       \
+    }                                                                           \
+    ns = bench_now_ns() - t0;                                                   \
+    name##_destroy(dq);                                                         \
+} while (__LINE__ == -1)
+
+/* ns of the run, 0 returned if failed. */
+static uint64_t run_typed(int steady, size_t elem_size, size_t backlog, size_t n,
+                          size_t *checksum)
+{
+    uint64_t t0, ns;
+    if (elem_size == sizeof(size_t)) {
+        size_t elem = 0;
+        BENCH_DQ_TYPED_RUN(bench_dq8, elem, elem);
+    }
+    else {
+        struct bench_dq_elem64 elem = { 0 };
+        BENCH_DQ_TYPED_RUN(bench_dq64, elem, elem.value);
+    }
+    return ns ? ns : 1;
+}
+
+/* ## one run of @test for @impl. */
+enum { IMPL_TWO_ALLOC, IMPL_SINGLE_ALLOC, IMPL_SINGLE_ALLOC_PAGE, IMPL_GROWING, IMPL_SPILLING,
+       IMPL_TYPED };
+static const char *impl_names[] = { "two_alloc", "single_alloc", "single_alloc_page", "growing",
+                                    "spilling", "typed" };
+
+static int run_one(int impl, int steady, size_t elem_size, size_t n)
+{
+    char elem[BENCH_DQ_MAX_ELEM_SIZE] = {0};
+    size_t backlog = steady ? 10000 : n;
+    size_t checksum = 0, expected = 0;
+    size_t allocs = 0, bytes = 0;
+    uint64_t t0, ns;
+    
+    if (impl == IMPL_TYPED) {
+        ns = run_typed(steady, elem_size, backlog, n, &checksum);
+        if (ns == 0)
+            return -1;
+    }
+    else if (impl == IMPL_TWO_ALLOC) {
+        struct legacy_deque dq = { .elem_size = elem_size };
+        t0 = bench_now_ns();
+        for (size_t i = 0; i < backlog; i++) {
+            *(size_t *)elem = i;
+            legacy_push_back(&dq, elem);
+        }
+        if (steady) {
+            t0 = bench_now_ns();
+            for (size_t i = 0; i < n; i++) {
+                *(size_t *)elem = backlog + i;
+                legacy_push_back(&dq, elem);
+                legacy_pop_front(&dq, elem);
+                checksum += *(size_t *)elem;
+            }
+        }
+        else {
+            for (size_t i = 0; i < n; i++) {
+                legacy_pop_front(&dq, elem);
+                checksum += *(size_t *)elem;
+            }
+        }
+        ns = bench_now_ns() - t0;
+        allocs = dq.allocs;
+        legacy_destroy(&dq);
+    }
+    else {
+        // a pool keeping nothing (watermarks 0) only counts the block allocations.
+        int behavior = SAKUC_DEQUE_SWEEP_IMMEDIATELY
+                       | (impl == IMPL_SINGLE_ALLOC_PAGE ? SAKUC_DEQUE_PAGE_BLOCKS : 0);
+        sakuc_deque_t *probe = sakuc_deque_new(BENCH_DQ_BLOCK, elem_size, behavior);
+        if (!probe)
+            return -1;
+        sakuc_deque_pool_t *pool = sakuc_deque_pool_new(probe->sub_deque_size, elem_size, 0, 0);
+        sakuc_deque_destroy(probe);
+        // the spilling one keeps 1/8 of the backlog in memory.
+        sakuc_deque_t *dq;
+        if (impl == IMPL_GROWING)
+            dq = sakuc_deque_new_growing(BENCH_DQ_BLOCK, 64 * BENCH_DQ_BLOCK, elem_size, behavior);
+        else if (impl == IMPL_SPILLING)
+            dq = sakuc_deque_new_spilling(BENCH_DQ_BLOCK, elem_size, behavior,
+                                          backlog * elem_size / 8, nullptr);
+        else
+            dq = sakuc_deque_new_with_pool(BENCH_DQ_BLOCK, elem_size, behavior, pool);
+        if (!pool || !dq)
+            return -1;
+    
+        t0 = bench_now_ns();
+        for (size_t i = 0; i < backlog; i++) {
+            *(size_t *)elem = i;
+            sakuc_deque_push_back(dq, elem, elem_size);
+        }
+        bytes = sakuc_deque_memory(dq, nullptr);
+        if (steady) {
+            t0 = bench_now_ns();
+            for (size_t i = 0; i < n; i++) {
+                *(size_t *)elem = backlog + i;
+                sakuc_deque_push_back(dq, elem, elem_size);
+                sakuc_deque_pop_front(dq, elem, elem_size);
+                checksum += *(size_t *)elem;
+            }
+        }
+        else {
+            for (size_t i = 0; i < n; i++) {
+                sakuc_deque_pop_front(dq, elem, elem_size);
+                checksum += *(size_t *)elem;
+            }
+        }
+        ns = bench_now_ns() - t0;
+        allocs = pool->misses;
+        sakuc_deque_destroy(dq);
+        sakuc_deque_pool_destroy(pool);
+    }
+    
+    for (size_t i = 0; i < n; i++)
+        expected += i;
+    
+    bench_emit_begin("deque");
+    bench_emit_str("test", steady ? "steady" : "fill_drain");
+    bench_emit_str("impl", impl_names[impl]);
+    bench_emit_uint("elem_size", elem_size);
+    bench_emit_uint("elements", n);
+    bench_emit_double("ns_elem", (double) ns / n);
+    if (impl != IMPL_TYPED && impl != IMPL_GROWING && impl != IMPL_SPILLING)
+        bench_emit_uint("block_allocs", allocs);
+    if (bytes > 0)
+        bench_emit_uint("backlog_bytes", bytes);
+    bench_emit_uint("checksum_ok", checksum == expected);
+    bench_emit_end();
+    return checksum == expected ? 0 : -1;
+}
+
+int bench_deque(const struct bench_options *opt)
+{
+    static const size_t elem_sizes[] = { 8, 64 };
+    size_t n = opt->full ? 50000000 : 5000000;
+    
+    for (size_t e = 0; e < sizeof(elem_sizes) / sizeof(elem_sizes[0]); e++) {
+        for (int steady = 0; steady <= 1; steady++) {
+            fprintf(stderr, "deque: %s, %zu bytes ...\n", steady ? "steady" : "fill_drain",
+                    elem_sizes[e]);
+            for (int impl = IMPL_TWO_ALLOC; impl <= IMPL_TYPED; impl++) {
+                if (run_one(impl, steady, elem_sizes[e], n) == -1)
+                    return -1;
+            }
+        }
+    }
+    
+    return 0;
+}
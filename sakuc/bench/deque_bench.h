@@ -0,0 +1,9 @@
+#ifndef SAKUC_DEQUE_BENCH_H_
+#define SAKUC_DEQUE_BENCH_H_
+
+#include "common_bench_defs.h"
+
+// return -1 if benchmark failed to run.
+extern int bench_deque(const struct bench_options *opt);
+
+#endif // SAKUC_DEQUE_BENCH_H_
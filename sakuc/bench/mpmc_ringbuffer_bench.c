@@ -0,0 +1,147 @@
+/* Scaling benchmark of mpmc_ringbuffer_t.
+
+    Vary the number of producer and consumer threads, and compare with the same
+    traffic through a ringbuffer_t protected by one pthread_mutex_t.
+
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include "../src/ringbuffer.h"
+#include "../src/mpmc_ringbuffer.h"
+#include "mpmc_ringbuffer_bench.h"
+
+#define BENCH_MPMC_MAX_THREADS 8
+#define BENCH_MPMC_ELEM_SIZE 16
+#define BENCH_MPMC_CAPACITY 4096
+
+struct bench_mpmc_ctx {
+    int locked;                 // mutex-protected ringbuffer_t instead of mpmc.
+    mpmc_ringbuffer_t *rb;
+    ringbuffer_t *locked_rb;
+    pthread_mutex_t lock;
+    size_t messages_per_producer;
+    size_t num_messages;
+    size_t num_consumed;
+};
+
+static int bench_push(struct bench_mpmc_ctx *ctx, const void *msg)
+{
+    if (!ctx->locked)
+        return mpmc_rbuf_push_back(ctx->rb, msg, BENCH_MPMC_ELEM_SIZE);
+    
+    int ret = -1;
+    pthread_mutex_lock(&ctx->lock);
+    // rbuf_push_back overwrites when full, check the length first.
+    if (rbuf_length(ctx->locked_rb) < ctx->locked_rb->capacity)
+        ret = rbuf_push_back(ctx->locked_rb, (void *) msg, BENCH_MPMC_ELEM_SIZE);
+    pthread_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+static void *bench_pop(struct bench_mpmc_ctx *ctx, void *msg)
+{
+    if (!ctx->locked)
+        return mpmc_rbuf_pop_front(ctx->rb, msg, BENCH_MPMC_ELEM_SIZE);
+    
+    pthread_mutex_lock(&ctx->lock);
+    void *ret = rbuf_pop_front(ctx->locked_rb, msg, BENCH_MPMC_ELEM_SIZE);
+    pthread_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+static void *producer_thread(void *arg)
+{
+    struct bench_mpmc_ctx *ctx = arg;
+    char msg[BENCH_MPMC_ELEM_SIZE] = {0};
+    for (size_t i = 0; i < ctx->messages_per_producer; i++) {
+        int spins = 0;
+        *(size_t *)msg = i;
+        while (bench_push(ctx, msg) == -1)
+            bench_backoff(spins);
+    }
+    return nullptr;
+}
+
+static void *consumer_thread(void *arg)
+{
+    struct bench_mpmc_ctx *ctx = arg;
+    char msg[BENCH_MPMC_ELEM_SIZE];
+    int spins = 0;
+    while (osal_atomic_load_relaxed(&ctx->num_consumed) < ctx->num_messages) {
+        if (bench_pop(ctx, msg) == nullptr) {
+            bench_backoff(spins);
+            continue;
+        }
+        spins = 0;
+        osal_atomic_fetch_add(&ctx->num_consumed, 1);
+    }
+    return nullptr;
+}
+
+static int run_case(struct bench_mpmc_ctx *ctx, size_t num_producers, size_t num_consumers)
+{
+    pthread_t threads[2 * BENCH_MPMC_MAX_THREADS];
+    size_t num_threads = 0;
+    
+    ctx->messages_per_producer = ctx->num_messages / num_producers;
+    ctx->num_messages = ctx->messages_per_producer * num_producers;
+    ctx->num_consumed = 0;
+    
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < num_consumers; i++)
+        if (pthread_create(&threads[num_threads++], nullptr, consumer_thread, ctx) != 0)
+            return -1;
+    for (size_t i = 0; i < num_producers; i++)
+        if (pthread_create(&threads[num_threads++], nullptr, producer_thread, ctx) != 0)
+            return -1;
+    for (size_t i = 0; i < num_threads; i++)
+        pthread_join(threads[i], nullptr);
+    uint64_t ns = bench_now_ns() - t0;
+    
+    double s = ns ? ns / 1e9 : 1e-9;
+    bench_emit_begin("mpmc_ringbuffer");
+    bench_emit_str("impl", ctx->locked ? "mutex_ringbuffer" : "mpmc");
+    bench_emit_uint("producers", num_producers);
+    bench_emit_uint("consumers", num_consumers);
+    bench_emit_uint("elem_size", BENCH_MPMC_ELEM_SIZE);
+    bench_emit_uint("capacity", BENCH_MPMC_CAPACITY);
+    bench_emit_uint("messages", ctx->num_messages);
+    bench_emit_double("msgs_s", ctx->num_messages / s);
+    bench_emit_end();
+    return 0;
+}
+
+int bench_mpmc_ringbuffer(const struct bench_options *opt)
+{
+    static const size_t num_threads[] = { 1, 2, 4, BENCH_MPMC_MAX_THREADS };
+    static const size_t num_cases = sizeof(num_threads) / sizeof(num_threads[0]);
+    size_t num_messages = opt->full ? 20000000 : 1000000;
+    struct bench_mpmc_ctx ctx;
+    
+    ctx.rb = mpmc_rbuf_new(BENCH_MPMC_CAPACITY, BENCH_MPMC_ELEM_SIZE);
+    ctx.locked_rb = rbuf_new(BENCH_MPMC_CAPACITY, BENCH_MPMC_ELEM_SIZE);
+    if (!ctx.rb || !ctx.locked_rb)
+        return -1;
+    pthread_mutex_init(&ctx.lock, nullptr);
+    
+    for (ctx.locked = FALSE; ctx.locked <= TRUE; ctx.locked++) {
+        for (size_t p = 0; p < num_cases; p++) {
+            for (size_t c = 0; c < num_cases; c++) {
+                fprintf(stderr, "mpmc: %s, %zu producers, %zu consumers ...\n",
+                        ctx.locked ? "mutex" : "mpmc", num_threads[p], num_threads[c]);
+                ctx.num_messages = num_messages;
+                if (run_case(&ctx, num_threads[p], num_threads[c]) == -1)
+                    return -1;
+            }
+        }
+    }
+    
+    pthread_mutex_destroy(&ctx.lock);
+    rbuf_destroy(ctx.locked_rb);
+    mpmc_rbuf_destroy(ctx.rb);
+    return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef SAKUC_MPMC_RINGBUFFER_BENCH_H_
+#define SAKUC_MPMC_RINGBUFFER_BENCH_H_
+
+#include "common_bench_defs.h"
+
+// return -1 if benchmark failed to run.
+extern int bench_mpmc_ringbuffer(const struct bench_options *opt);
+
+#endif // SAKUC_MPMC_RINGBUFFER_BENCH_H_
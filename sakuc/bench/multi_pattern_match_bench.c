@@ -0,0 +1,213 @@
+/* Benchmark of the multi-pattern matcher.
+
+    Synthetic and reproducible workloads (same seed => same text and patterns):
+        random  - lowercase letters, uniformly distributed.
+        english - words of a small vocabulary with zipf-like frequencies.
+        binary  - any byte value (patterns exclude '\0', they are C strings).
+
+    For each (workload, #patterns, pattern length, match density) case, measure
+    build time, scan MB/s, matches/s, peak RSS and destroy time.
+
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include "../src/multi_pattern_match.h"
+#include "multi_pattern_match_bench.h"
+
+#define BENCH_MPM_FIFO_INIT_SIZE 1024
+
+enum bench_mpm_workload {
+    BENCH_MPM_RANDOM = 0,
+    BENCH_MPM_ENGLISH,
+    BENCH_MPM_BINARY,
+};
+
+static const char *workload_names[] = { "random", "english", "binary" };
+
+static const char *english_words[] = {
+    "the", "of", "and", "to", "a", "in", "is", "it", "you", "that",
+    "he", "was", "for", "on", "are", "with", "as", "his", "they", "be",
+    "at", "one", "have", "this", "from", "or", "had", "by", "word", "but",
+    "what", "some", "we", "can", "out", "other", "were", "all", "there", "when",
+    "up", "use", "your", "how", "said", "an", "each", "she", "which", "do",
+    "their", "time", "if", "will", "way", "about", "many", "then", "them", "write",
+    "would", "like", "so", "these", "her", "long", "make", "thing", "see", "him",
+    "two", "has", "look", "more", "day", "could", "go", "come", "did", "number",
+    "sound", "no", "most", "people", "my", "over", "know", "water", "than", "call",
+    "first", "who", "may", "down", "side", "been", "now", "find", "hello", "world",
+};
+
+static const size_t num_english_words = sizeof(english_words) / sizeof(english_words[0]);
+
+/* Fill @buf with @len bytes of @workload, '\0' excluded if @no_nul. */
+static void gen_stream(enum bench_mpm_workload workload, uint64_t *rng,
+                       char *buf, size_t len, int no_nul)
+{
+    size_t i = 0;
+    switch (workload) {
+    case BENCH_MPM_RANDOM:
+        for (; i < len; i++)
+            buf[i] = 'a' + bench_rand(rng) % 26;
+        break;
+    case BENCH_MPM_ENGLISH:
+        while (i < len) {
+            // zipf-like: lower ranks are much more frequent.
+            size_t r = bench_rand(rng) % num_english_words;
+            const char *w = english_words[bench_rand(rng) % (r + 1)];
+            for (; *w && i < len; w++)
+                buf[i++] = *w;
+            if (i < len)
+                buf[i++] = (bench_rand(rng) % 16 == 0) ? '.' : ' ';
+        }
+        break;
+    case BENCH_MPM_BINARY:
+        for (; i < len; i++) {
+            buf[i] = (char) (bench_rand(rng) & 0xff);
+            if (no_nul && buf[i] == 0)
+                buf[i] = 1;
+        }
+        break;
+    }
+}
+
+struct bench_mpm_case {
+    enum bench_mpm_workload workload;
+    size_t num_patterns;
+    size_t pattern_len;
+    size_t density;     // patterns planted per KB of input stream.
+};
+
+static int run_case(const struct bench_options *opt, const struct bench_mpm_case *c,
+                    size_t text_len)
+{
+    uint64_t rng = opt->seed ? opt->seed : 1;
+    char *pool = malloc(c->num_patterns * (c->pattern_len + 1));
+    const char **keywords = malloc(c->num_patterns * sizeof(char *));
+    char *text = malloc(text_len);
+    if (!pool || !keywords || !text) {
+        free(pool); free(keywords); free(text);
+        return -1;
+    }
+
+    // patterns are drawn from the same distribution as the text.
+    for (size_t i = 0; i < c->num_patterns; i++) {
+        char *p = pool + i * (c->pattern_len + 1);
+        gen_stream(c->workload, &rng, p, c->pattern_len, TRUE);
+        p[c->pattern_len] = '\0';
+        keywords[i] = p;
+    }
+
+    gen_stream(c->workload, &rng, text, text_len, FALSE);
+    size_t num_planted = text_len / 1024 * c->density;
+    for (size_t i = 0; i < num_planted && text_len > c->pattern_len; i++) {
+        size_t pos = bench_rand(&rng) % (text_len - c->pattern_len);
+        memcpy(text + pos, keywords[bench_rand(&rng) % c->num_patterns], c->pattern_len);
+    }
+
+    // ## build
+    bench_reset_peak_rss();
+    size_t rss_before = bench_rss_kb();
+
+    struct trie_node *search_db = nullptr;
+    uint64_t t0 = bench_now_ns();
+    int ret = sakuc_multi_pattern_build_search_automaton
+                (&search_db, keywords, c->num_patterns, BENCH_MPM_FIFO_INIT_SIZE);
+    uint64_t build_ns = bench_now_ns() - t0;
+    size_t rss_after = bench_rss_kb();
+    size_t rss_automaton = rss_after > rss_before ? rss_after - rss_before : 0;
+
+    if (ret != 0 || !search_db) {
+        free(pool); free(keywords); free(text);
+        return -1;
+    }
+
+    // ## scan
+    size_t pos = 0;
+    const char *matched_keyword = nullptr;
+    size_t num_matches = 0;
+
+    t0 = bench_now_ns();
+    ret = sakuc_multi_pattern_search(search_db, SAKUC_MPM_SEARCH_MODE_START,
+                                     text, text_len, &pos, &matched_keyword);
+    while (ret == 1) {
+        ++ num_matches;
+        ret = sakuc_multi_pattern_search(search_db, SAKUC_MPM_SEARCH_MODE_CONTINUE,
+                                         text, text_len, &pos, &matched_keyword);
+    }
+    uint64_t scan_ns = bench_now_ns() - t0;
+    size_t peak_rss = bench_peak_rss_kb();
+
+    // ## destroy
+    t0 = bench_now_ns();
+    int destroy_ret = sakuc_multi_pattern_destroy_search_automaton
+                        (search_db, BENCH_MPM_FIFO_INIT_SIZE);
+    uint64_t destroy_ns = bench_now_ns() - t0;
+
+    double scan_s = scan_ns ? scan_ns / 1e9 : 1e-9;
+    bench_emit_begin("multi_pattern_match");
+    bench_emit_str("workload", workload_names[c->workload]);
+    bench_emit_uint("patterns", c->num_patterns);
+    bench_emit_uint("pattern_len", c->pattern_len);
+    bench_emit_uint("density_per_kb", c->density);
+    bench_emit_uint("text_bytes", text_len);
+    bench_emit_uint("seed", opt->seed);
+    bench_emit_double("build_ms", build_ns / 1e6);
+    bench_emit_double("scan_mb_s", text_len / scan_s / (1024.0 * 1024.0));
+    bench_emit_uint("matches", num_matches);
+    bench_emit_double("matches_s", num_matches / scan_s);
+    bench_emit_uint("automaton_rss_kb", rss_automaton);
+    bench_emit_uint("peak_rss_kb", peak_rss);
+    bench_emit_double("destroy_ms", destroy_ns / 1e6);
+    bench_emit_end();
+
+    free(pool); free(keywords); free(text);
+    return (ret == -1 || destroy_ret != 0) ? -1 : 0;
+}
+
+int bench_multi_pattern_match(const struct bench_options *opt)
+{
+    static const size_t quick_patterns[] = { 10, 100, 1000, 10000 };
+    static const size_t full_patterns[] = { 10, 100, 1000, 10000, 100000, 1000000 };
+    static const size_t pattern_lens[] = { 4, 8, 16, 32 };
+    static const size_t densities[] = { 0, 1, 10 };
+
+    const size_t *patterns = opt->full ? full_patterns : quick_patterns;
+    size_t num_patterns_cases = opt->full ?
+        sizeof(full_patterns) / sizeof(full_patterns[0]) :
+        sizeof(quick_patterns) / sizeof(quick_patterns[0]);
+    size_t text_len = (opt->text_mb ? opt->text_mb : (opt->full ? 32 : 4)) * 1024 * 1024;
+
+    struct bench_mpm_case c;
+    for (int w = BENCH_MPM_RANDOM; w <= BENCH_MPM_BINARY; w++) {
+        c.workload = w;
+
+        // #patterns sweep, fixed length and density.
+        c.pattern_len = 8; c.density = 1;
+        for (size_t i = 0; i < num_patterns_cases; i++) {
+            c.num_patterns = patterns[i];
+            fprintf(stderr, "mpm: %s, %zu patterns ...\n", workload_names[w], c.num_patterns);
+            if (run_case(opt, &c, text_len) == -1)
+                return -1;
+        }
+
+        // pattern length and density sweep, fixed #patterns.
+        c.num_patterns = 1000;
+        for (size_t i = 0; i < sizeof(pattern_lens) / sizeof(pattern_lens[0]); i++) {
+            for (size_t j = 0; j < sizeof(densities) / sizeof(densities[0]); j++) {
+                c.pattern_len = pattern_lens[i]; c.density = densities[j];
+                if (c.pattern_len == 8 && c.density == 1)
+                    continue; // already covered above.
+                fprintf(stderr, "mpm: %s, length %zu, density %zu/KB ...\n",
+                        workload_names[w], c.pattern_len, c.density);
+                if (run_case(opt, &c, text_len) == -1)
+                    return -1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+/* Single-thread benchmark of ringbuffer_t.
+
+    one-by-one - rbuf_push_back / rbuf_pop_front per element.
+    batch      - rbuf_push_back_n / rbuf_pop_front_n, @batch elements per call.
+    zero-copy  - large records built and read in place, rbuf_reserve_back +
+                 rbuf_commit_back / rbuf_peek_front + rbuf_consume_front,
+                 compared with building the record aside and copying it.
+    wakeup     - a RBUF_OVERFLOW_BLOCK ring fed every ~50us by a producer thread;
+                 wakeup latency and cpu usage of a consumer sleeping in
+                 rbuf_pop_front_timed, in epoll on rbuf_eventfd, or spinning.
+    typed      - SAKUC_RINGBUFFER_DEFINE rings of uint32_t and of a 16 bytes struct,
+                 to be compared with one-by-one of the same element size.
+
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+#include "../src/ringbuffer.h"
+#include "../src/typed_ringbuffer.h"
+#include "ringbuffer_bench.h"
+
+#define BENCH_RBUF_CAPACITY 4096
+#define BENCH_RBUF_MAX_BATCH 256
+
+struct bench_rbuf_elem16 {
+    uint64_t a; uint64_t b;
+};
+
+SAKUC_RINGBUFFER_DEFINE(bench_u32_rbuf, uint32_t)
+SAKUC_RINGBUFFER_DEFINE(bench_elem16_rbuf, struct bench_rbuf_elem16)
+
+static void emit_result(const char *api, size_t elem_size, size_t batch,
+                        size_t num_elems, uint64_t ns, uint64_t checksum)
+{
+    double s = ns ? ns / 1e9 : 1e-9;
+    bench_emit_begin("ringbuffer");
+    bench_emit_str("api", api);
+    bench_emit_uint("elem_size", elem_size);
+    bench_emit_uint("batch", batch);
+    bench_emit_uint("elements", num_elems);
+    bench_emit_double("melems_s", num_elems / s / 1e6);
+    bench_emit_double("mb_s", num_elems * elem_size / s / (1024.0 * 1024.0));
+    bench_emit_uint("checksum", checksum);
+    bench_emit_end();
+}
+
+static int run_case(size_t elem_size, size_t batch, size_t num_elems)
+{
+    ringbuffer_t *rb = rbuf_new(BENCH_RBUF_CAPACITY, elem_size);
+    char *in = calloc(BENCH_RBUF_MAX_BATCH, elem_size);
+    char *out = calloc(BENCH_RBUF_MAX_BATCH, elem_size);
+    if (!rb || !in || !out)
+        return -1;
+    for (size_t i = 0; i < BENCH_RBUF_MAX_BATCH * elem_size; i++)
+        in[i] = (char) (i + 1);
+    
+    // the checksum keeps the compiler from dropping the copies.
+    uint64_t checksum = 0;
+    uint64_t t0 = bench_now_ns();
+    if (batch == 1) {
+        for (size_t i = 0; i < num_elems; i++) {
+            rbuf_push_back(rb, in, elem_size);
+            rbuf_pop_front(rb, out, elem_size);
+            checksum += (unsigned char) out[0];
+        }
+    }
+    else {
+        for (size_t i = 0; i < num_elems; i += batch) {
+            rbuf_push_back_n(rb, in, batch, elem_size, FALSE);
+            rbuf_pop_front_n(rb, out, batch, elem_size);
+            checksum += (unsigned char) out[0];
+        }
+    }
+    emit_result(batch == 1 ? "one_by_one" : "batch", elem_size, batch, num_elems,
+                bench_now_ns() - t0, checksum);
+    
+    free(in); free(out);
+    rbuf_destroy(rb);
+    return 0;
+}
+
+static int run_record_case(size_t record_size, int zero_copy, size_t num_records)
+{
+    ringbuffer_t *rb = rbuf_new(BENCH_RBUF_CAPACITY, record_size);
+    char *in = calloc(1, record_size);
+    char *out = calloc(1, record_size);
+    if (!rb || !in || !out)
+        return -1;
+    
+    // only the record header (a sequence number) is written and read back.
+    struct rbuf_region regions[2];
+    uint64_t checksum = 0;
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < num_records; i++) {
+        if (zero_copy) {
+            rbuf_reserve_back(rb, 1, regions);
+            *(size_t *)regions[0].data = i;
+            rbuf_commit_back(rb, 1);
+            
+            rbuf_peek_front(rb, 1, regions);
+            checksum += *(size_t *)regions[0].data;
+            rbuf_consume_front(rb, 1);
+        }
+        else {
+            *(size_t *)in = i;
+            rbuf_push_back(rb, in, record_size);
+            
+            rbuf_pop_front(rb, out, record_size);
+            checksum += *(size_t *)out;
+        }
+    }
+    emit_result(zero_copy ? "zero_copy" : "one_by_one", record_size, 1, num_records,
+                bench_now_ns() - t0, checksum);
+    
+    free(in); free(out);
+    rbuf_destroy(rb);
+    return 0;
+}
+
+static int run_typed_case(size_t num_elems)
+{
+    uint64_t checksum = 0;
+    uint64_t t0 = 0;
+    
+    bench_u32_rbuf_t *u32_rb = bench_u32_rbuf_new(BENCH_RBUF_CAPACITY);
+    if (!u32_rb)
+        return -1;
+    uint32_t u32 = 0;
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < num_elems; i++) {
+        bench_u32_rbuf_push_back(u32_rb, (uint32_t) i);
+        bench_u32_rbuf_pop_front(u32_rb, &u32);
+        checksum += u32;
+    }
+    emit_result("typed", sizeof(uint32_t), 1, num_elems, bench_now_ns() - t0, checksum);
+    bench_u32_rbuf_destroy(u32_rb);
+    
+    bench_elem16_rbuf_t *elem16_rb = bench_elem16_rbuf_new(BENCH_RBUF_CAPACITY);
+    if (!elem16_rb)
+        return -1;
+    struct bench_rbuf_elem16 elem16 = { 0, 0 };
+    checksum = 0;
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < num_elems; i++) {
+        struct bench_rbuf_elem16 e = { .a = i, .b = ~i };
+        bench_elem16_rbuf_push_back(elem16_rb, e);
+        bench_elem16_rbuf_pop_front(elem16_rb, &elem16);
+        checksum += elem16.a;
+    }
+    emit_result("typed", sizeof(struct bench_rbuf_elem16), 1, num_elems,
+                bench_now_ns() - t0, checksum);
+    bench_elem16_rbuf_destroy(elem16_rb);
+    
+    return 0;
+}
+
+enum bench_wakeup_mode {
+    BENCH_WAKEUP_BLOCKING = 0,
+    BENCH_WAKEUP_EVENTFD,
+    BENCH_WAKEUP_SPINNING,
+};
+
+static const char *wakeup_mode_names[] = { "blocking", "eventfd", "spinning" };
+
+struct bench_wakeup_ctx {
+    ringbuffer_t *rb;
+    size_t num_messages;
+};
+
+static void *wakeup_producer(void *arg)
+{
+    struct bench_wakeup_ctx *ctx = arg;
+    struct timespec gap = { .tv_sec = 0, .tv_nsec = 50000 };
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        nanosleep(&gap, nullptr);
+        uint64_t sent = bench_now_ns();
+        rbuf_push_back(ctx->rb, &sent, sizeof(sent));
+    }
+    return nullptr;
+}
+
+static int cmp_uint64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_wakeup_case(enum bench_wakeup_mode mode, size_t num_messages)
+{
+    struct bench_wakeup_ctx ctx = { .num_messages = num_messages };
+    uint64_t *latency = malloc(num_messages * sizeof(uint64_t));
+    ctx.rb = rbuf_new_with_policy(BENCH_RBUF_CAPACITY, sizeof(uint64_t), RBUF_OVERFLOW_BLOCK);
+    if (!latency || !ctx.rb)
+        return -1;
+    
+    int epfd = -1;
+#ifdef __linux__
+    if (mode == BENCH_WAKEUP_EVENTFD) {
+        struct epoll_event ev = { .events = EPOLLIN };
+        epfd = epoll_create1(0);
+        if (epfd < 0 || epoll_ctl(epfd, EPOLL_CTL_ADD, rbuf_eventfd(ctx.rb), &ev) != 0)
+            return -1;
+    }
+#else
+    if (mode == BENCH_WAKEUP_EVENTFD)
+        return 0;
+#endif
+    
+    pthread_t producer;
+    uint64_t cpu0 = bench_cpu_ns();
+    uint64_t t0 = bench_now_ns();
+    if (pthread_create(&producer, nullptr, wakeup_producer, &ctx) != 0)
+        return -1;
+    
+    uint64_t sent;
+    for (size_t i = 0; i < num_messages; ) {
+        switch (mode) {
+        case BENCH_WAKEUP_BLOCKING:
+            if (!rbuf_pop_front_timed(ctx.rb, &sent, sizeof(sent), -1))
+                continue;
+            break;
+#ifdef __linux__
+        case BENCH_WAKEUP_EVENTFD:
+            if (!rbuf_pop_front(ctx.rb, &sent, sizeof(sent))) {
+                struct epoll_event ev;
+                uint64_t events;
+                if (epoll_wait(epfd, &ev, 1, -1) == 1) {
+                    // reset the counter before draining.
+                    ssize_t ret = read(rbuf_eventfd(ctx.rb), &events, sizeof(events));
+                    (void) ret;
+                }
+                continue;
+            }
+            break;
+#endif
+        default: {
+            int spins = 0;
+            while (!rbuf_pop_front(ctx.rb, &sent, sizeof(sent)))
+                bench_backoff(spins);
+            break;
+        }
+        }
+        latency[i++] = bench_now_ns() - sent;
+    }
+    pthread_join(producer, nullptr);
+    uint64_t wall_ns = bench_now_ns() - t0;
+    uint64_t cpu_ns = bench_cpu_ns() - cpu0;
+    
+    qsort(latency, num_messages, sizeof(uint64_t), cmp_uint64);
+    bench_emit_begin("ringbuffer");
+    bench_emit_str("api", "wakeup");
+    bench_emit_str("mode", wakeup_mode_names[mode]);
+    bench_emit_uint("messages", num_messages);
+    bench_emit_uint("latency_p50_ns", latency[num_messages / 2]);
+    bench_emit_uint("latency_p99_ns", latency[num_messages * 99 / 100]);
+    bench_emit_uint("latency_max_ns", latency[num_messages - 1]);
+    bench_emit_double("cpu_usage", wall_ns ? (double) cpu_ns / wall_ns : 0);
+    bench_emit_end();
+    
+    if (epfd >= 0)
+        close(epfd);
+    rbuf_destroy(ctx.rb);
+    free(latency);
+    return 0;
+}
+
+int bench_ringbuffer(const struct bench_options *opt)
+{
+    static const size_t elem_sizes[] = { 1, 4, 8, 16, 64 };
+    static const size_t batches[] = { 1, 16, 64, BENCH_RBUF_MAX_BATCH };
+    size_t num_elems = opt->full ? 256 * 1024 * 1024 : 16 * 1024 * 1024;
+    
+    for (size_t i = 0; i < sizeof(elem_sizes) / sizeof(elem_sizes[0]); i++) {
+        for (size_t j = 0; j < sizeof(batches) / sizeof(batches[0]); j++) {
+            fprintf(stderr, "ringbuffer: %zu bytes, batch %zu ...\n", elem_sizes[i], batches[j]);
+            if (run_case(elem_sizes[i], batches[j], num_elems) == -1)
+                return -1;
+        }
+    }
+    
+    fprintf(stderr, "ringbuffer: typed ...\n");
+    if (run_typed_case(num_elems) == -1)
+        return -1;
+    
+    for (int mode = BENCH_WAKEUP_BLOCKING; mode <= BENCH_WAKEUP_SPINNING; mode++) {
+        fprintf(stderr, "ringbuffer: wakeup, %s ...\n", wakeup_mode_names[mode]);
+        if (run_wakeup_case(mode, opt->full ? 100000 : 5000) == -1)
+            return -1;
+    }
+    
+    static const size_t record_sizes[] = { 256, 1024, 4096 };
+    size_t num_records = opt->full ? 16 * 1024 * 1024 : 1024 * 1024;
+    for (size_t i = 0; i < sizeof(record_sizes) / sizeof(record_sizes[0]); i++) {
+        for (int zero_copy = FALSE; zero_copy <= TRUE; zero_copy++) {
+            fprintf(stderr, "ringbuffer: %zu bytes records, %s ...\n", record_sizes[i],
+                    zero_copy ? "zero-copy" : "copy");
+            if (run_record_case(record_sizes[i], zero_copy, num_records) == -1)
+                return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+/* Rolling min / max of a random walk stream, sliding_window_t against a rescan.
+
+    single - one window, min and max queried after every sample:
+                 monotonic - #swin_push then #swin_min / #swin_max.
+                 batch     - #swin_push_n of BENCH_SWIN_BATCH samples, then queried.
+                 naive     - a ring of the last samples, rescanned for every query
+                             (fewer samples, it is O(window) per sample).
+    multi  - windows of 1K, 10K, 100K and 1M samples over the same stream, all queried
+             after every sample:
+                 shared    - one sliding_window_t with the four windows.
+                 separate  - four sliding_window_t of one window each.
+    The window is filled first, untimed. "checksum_ok" - the min / max of the samples
+    timed by the naive rescan are the same for every impl.
+    
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include "../src/sliding_window.h"
+#include "sliding_window_bench.h"
+
+#define BENCH_SWIN_BATCH 1000
+
+/* random walk, the next sample. */
+static inline double bench_swin_next(uint64_t *state, double *walk)
+{
+    *walk += (double) (bench_rand(state) % 2001) / 1000.0 - 1.0;
+    return *walk;
+}
+
+/*  ns per sample of @impl over @n samples (after @window untimed ones) for one window.
+    @checksum - sum of min + max over the first @checked timed samples.
+ */
+enum { IMPL_MONOTONIC, IMPL_BATCH, IMPL_NAIVE };
+static const char *single_impl_names[] = { "monotonic", "batch", "naive" };
+
+static double run_single(int impl, size_t window, size_t n, size_t checked, uint64_t seed,
+                         double *checksum)
+{
+    uint64_t state = seed;
+    double walk = 0, min, max;
+    uint64_t t0 = 0;
+    *checksum = 0;
+    
+    if (impl == IMPL_NAIVE) {
+        double *ring = (double *) malloc(window * sizeof(double));
+        if (!ring)
+            return -1;
+        for (size_t i = 0; i < window; i++)
+            ring[i] = bench_swin_next(&state, &walk);
+        t0 = bench_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            ring[(window + i) % window] = bench_swin_next(&state, &walk);
+            min = max = ring[0];
+            for (size_t j = 1; j < window; j++) {
+                if (ring[j] < min)
+                    min = ring[j];
+                if (ring[j] > max)
+                    max = ring[j];
+            }
+            if (i < checked)
+                *checksum += min + max;
+        }
+        free(ring);
+        return (double) (bench_now_ns() - t0) / n;
+    }
+    
+    sliding_window_t *sw = swin_new(&window, 1);
+    double *batch = (double *) malloc(BENCH_SWIN_BATCH * sizeof(double));
+    if (!sw || !batch)
+        return -1;
+    for (size_t i = 0; i < window; i++)
+        swin_push(sw, bench_swin_next(&state, &walk));
+    
+    t0 = bench_now_ns();
+    if (impl == IMPL_MONOTONIC) {
+        for (size_t i = 0; i < n; i++) {
+            swin_push(sw, bench_swin_next(&state, &walk));
+            swin_min(sw, 0, &min);
+            swin_max(sw, 0, &max);
+            if (i < checked)
+                *checksum += min + max;
+        }
+    }
+    else {
+        // the batch results are compared one sample at a time, untimed.
+        for (size_t i = 0; i < checked; i++) {
+            swin_push(sw, bench_swin_next(&state, &walk));
+            swin_min(sw, 0, &min);
+            swin_max(sw, 0, &max);
+            *checksum += min + max;
+        }
+        t0 = bench_now_ns();
+        for (size_t i = checked; i < n; i += BENCH_SWIN_BATCH) {
+            size_t m = n - i < BENCH_SWIN_BATCH ? n - i : BENCH_SWIN_BATCH;
+            for (size_t j = 0; j < m; j++)
+                batch[j] = bench_swin_next(&state, &walk);
+            swin_push_n(sw, batch, m);
+            swin_min(sw, 0, &min);
+            swin_max(sw, 0, &max);
+        }
+        n -= checked;
+    }
+    uint64_t ns = bench_now_ns() - t0;
+    
+    free(batch);
+    swin_destroy(sw);
+    return (double) ns / n;
+}
+
+/* ns per sample of the four windows, @shared in one sliding_window_t or not. */
+static double run_multi(int shared, size_t n, uint64_t seed, double *checksum)
+{
+    static const size_t lengths[] = { 1000, 10000, 100000, 1000000 };
+    const size_t num_windows = sizeof(lengths) / sizeof(lengths[0]);
+    sliding_window_t *sws[sizeof(lengths) / sizeof(lengths[0])] = { nullptr };
+    uint64_t state = seed;
+    double walk = 0, min, max;
+    size_t num_sws = shared ? 1 : num_windows;
+    
+    for (size_t i = 0; i < num_sws; i++) {
+        sws[i] = shared ? swin_new(lengths, num_windows) : swin_new(&lengths[i], 1);
+        if (!sws[i])
+            return -1;
+    }
+    for (size_t i = 0; i < lengths[num_windows - 1]; i++) {
+        double value = bench_swin_next(&state, &walk);
+        for (size_t k = 0; k < num_sws; k++)
+            swin_push(sws[k], value);
+    }
+    
+    *checksum = 0;
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        double value = bench_swin_next(&state, &walk);
+        for (size_t k = 0; k < num_sws; k++)
+            swin_push(sws[k], value);
+        for (size_t w = 0; w < num_windows; w++) {
+            sliding_window_t *sw = shared ? sws[0] : sws[w];
+            swin_min(sw, shared ? w : 0, &min);
+            swin_max(sw, shared ? w : 0, &max);
+            *checksum += min + max;
+        }
+    }
+    uint64_t ns = bench_now_ns() - t0;
+    
+    for (size_t i = 0; i < num_sws; i++)
+        swin_destroy(sws[i]);
+    return (double) ns / n;
+}
+
+int bench_sliding_window(const struct bench_options *opt)
+{
+    static const size_t windows[] = { 1000, 1000000 };
+    size_t n = opt->full ? 50000000 : 5000000;
+    uint64_t seed = opt->seed ? opt->seed : 88172645463325252ull;
+    
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        // the naive rescan gets about 2 * 10^8 comparisons.
+        size_t naive_n = 200000000 / windows[w];
+        fprintf(stderr, "sliding_window: single, window %zu ...\n", windows[w]);
+        
+        double expected = 0;
+        for (int impl = IMPL_NAIVE; impl >= IMPL_MONOTONIC; impl--) {
+            double checksum;
+            double ns = run_single(impl, windows[w], impl == IMPL_NAIVE ? naive_n : n, naive_n,
+                                   seed, &checksum);
+            if (ns < 0)
+                return -1;
+            if (impl == IMPL_NAIVE)
+                expected = checksum;
+            
+            bench_emit_begin("sliding_window");
+            bench_emit_str("test", "single");
+            bench_emit_str("impl", single_impl_names[impl]);
+            bench_emit_uint("window", windows[w]);
+            bench_emit_uint("samples", impl == IMPL_NAIVE ? naive_n : n);
+            bench_emit_double("ns_sample", ns);
+            bench_emit_uint("checksum_ok", checksum == expected);
+            bench_emit_end();
+            if (checksum != expected)
+                return -1;
+        }
+    }
+    
+    fprintf(stderr, "sliding_window: multi ...\n");
+    double expected = 0;
+    for (int shared = 1; shared >= 0; shared--) {
+        double checksum;
+        double ns = run_multi(shared, n, seed, &checksum);
+        if (ns < 0)
+            return -1;
+        if (shared)
+            expected = checksum;
+        
+        bench_emit_begin("sliding_window");
+        bench_emit_str("test", "multi");
+        bench_emit_str("impl", shared ? "shared" : "separate");
+        bench_emit_uint("windows", 4);
+        bench_emit_uint("samples", n);
+        bench_emit_double("ns_sample", ns);
+        bench_emit_uint("checksum_ok", checksum == expected);
+        bench_emit_end();
+        if (checksum != expected)
+            return -1;
+    }
+    
+    return 0;
+}
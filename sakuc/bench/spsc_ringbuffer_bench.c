@@ -0,0 +1,219 @@
+/* Two-thread benchmark of spsc_ringbuffer_t.
+
+    throughput - one producer thread pushes, the main thread pops; compared with
+                 the same traffic through a mutex-protected ringbuffer_t.
+    latency    - ping-pong through two rings, round-trip time percentiles.
+
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "../src/ringbuffer.h"
+#include "../src/spsc_ringbuffer.h"
+#include "spsc_ringbuffer_bench.h"
+
+#define BENCH_SPSC_MAX_ELEM_SIZE 256
+
+struct bench_spsc_ctx {
+    spsc_ringbuffer_t *rb;
+    spsc_ringbuffer_t *reply;   // latency only.
+    ringbuffer_t *locked_rb;    // mutex baseline only.
+    pthread_mutex_t lock;
+    size_t elem_size;
+    size_t num_messages;
+};
+
+static void *spsc_producer(void *arg)
+{
+    struct bench_spsc_ctx *ctx = arg;
+    char msg[BENCH_SPSC_MAX_ELEM_SIZE] = {0};
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        *(size_t *)msg = i;
+        while (spsc_rbuf_push_back(ctx->rb, msg, ctx->elem_size) == -1)
+            bench_backoff(spins);
+    }
+    return nullptr;
+}
+
+static void *locked_producer(void *arg)
+{
+    struct bench_spsc_ctx *ctx = arg;
+    char msg[BENCH_SPSC_MAX_ELEM_SIZE] = {0};
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        *(size_t *)msg = i;
+        for (;;) {
+            // rbuf_push_back overwrites when full, check the length first.
+            pthread_mutex_lock(&ctx->lock);
+            int pushed = rbuf_length(ctx->locked_rb) < ctx->locked_rb->capacity
+                         && rbuf_push_back(ctx->locked_rb, msg, ctx->elem_size) == 0;
+            pthread_mutex_unlock(&ctx->lock);
+            if (pushed)
+                break;
+            bench_backoff(spins);
+        }
+    }
+    return nullptr;
+}
+
+static void *spsc_echo(void *arg)
+{
+    struct bench_spsc_ctx *ctx = arg;
+    char msg[BENCH_SPSC_MAX_ELEM_SIZE];
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        while (spsc_rbuf_pop_front(ctx->rb, msg, ctx->elem_size) == nullptr)
+            bench_backoff(spins);
+        while (spsc_rbuf_push_back(ctx->reply, msg, ctx->elem_size) == -1)
+            bench_backoff(spins);
+    }
+    return nullptr;
+}
+
+static void emit_throughput(const char *impl, struct bench_spsc_ctx *ctx, size_t capacity,
+                            uint64_t ns, int in_order)
+{
+    double s = ns ? ns / 1e9 : 1e-9;
+    bench_emit_begin("spsc_ringbuffer");
+    bench_emit_str("test", "throughput");
+    bench_emit_str("impl", impl);
+    bench_emit_uint("elem_size", ctx->elem_size);
+    bench_emit_uint("capacity", capacity);
+    bench_emit_uint("messages", ctx->num_messages);
+    bench_emit_double("msgs_s", ctx->num_messages / s);
+    bench_emit_double("mb_s", ctx->num_messages * ctx->elem_size / s / (1024.0 * 1024.0));
+    bench_emit_uint("in_order", in_order);
+    bench_emit_end();
+}
+
+static int run_throughput(struct bench_spsc_ctx *ctx, size_t capacity)
+{
+    char msg[BENCH_SPSC_MAX_ELEM_SIZE];
+    pthread_t producer;
+    int in_order = TRUE;
+    
+    // ## spsc_ringbuffer_t
+    ctx->rb = spsc_rbuf_new(capacity, ctx->elem_size);
+    if (!ctx->rb)
+        return -1;
+    
+    uint64_t t0 = bench_now_ns();
+    if (pthread_create(&producer, nullptr, spsc_producer, ctx) != 0)
+        return -1;
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        while (spsc_rbuf_pop_front(ctx->rb, msg, ctx->elem_size) == nullptr)
+            bench_backoff(spins);
+        if (*(size_t *)msg != i)
+            in_order = FALSE;
+    }
+    pthread_join(producer, nullptr);
+    emit_throughput("spsc", ctx, capacity, bench_now_ns() - t0, in_order);
+    spsc_rbuf_destroy(ctx->rb);
+    
+    // ## ringbuffer_t + pthread_mutex_t
+    ctx->locked_rb = rbuf_new(capacity, ctx->elem_size);
+    if (!ctx->locked_rb)
+        return -1;
+    pthread_mutex_init(&ctx->lock, nullptr);
+    
+    t0 = bench_now_ns();
+    if (pthread_create(&producer, nullptr, locked_producer, ctx) != 0)
+        return -1;
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        for (;;) {
+            pthread_mutex_lock(&ctx->lock);
+            void *popped = rbuf_pop_front(ctx->locked_rb, msg, ctx->elem_size);
+            pthread_mutex_unlock(&ctx->lock);
+            if (popped)
+                break;
+            bench_backoff(spins);
+        }
+        if (*(size_t *)msg != i)
+            in_order = FALSE;
+    }
+    pthread_join(producer, nullptr);
+    emit_throughput("mutex_ringbuffer", ctx, capacity, bench_now_ns() - t0, in_order);
+    pthread_mutex_destroy(&ctx->lock);
+    rbuf_destroy(ctx->locked_rb);
+    
+    return in_order ? 0 : -1;
+}
+
+static int cmp_uint64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_latency(struct bench_spsc_ctx *ctx)
+{
+    char msg[BENCH_SPSC_MAX_ELEM_SIZE] = {0};
+    uint64_t *rtt = malloc(ctx->num_messages * sizeof(uint64_t));
+    ctx->rb = spsc_rbuf_new(64, ctx->elem_size);
+    ctx->reply = spsc_rbuf_new(64, ctx->elem_size);
+    if (!rtt || !ctx->rb || !ctx->reply)
+        return -1;
+    
+    pthread_t echo;
+    if (pthread_create(&echo, nullptr, spsc_echo, ctx) != 0)
+        return -1;
+    for (size_t i = 0; i < ctx->num_messages; i++) {
+        int spins = 0;
+        uint64_t t0 = bench_now_ns();
+        while (spsc_rbuf_push_back(ctx->rb, msg, ctx->elem_size) == -1)
+            bench_backoff(spins);
+        while (spsc_rbuf_pop_front(ctx->reply, msg, ctx->elem_size) == nullptr)
+            bench_backoff(spins);
+        rtt[i] = bench_now_ns() - t0;
+    }
+    pthread_join(echo, nullptr);
+    
+    qsort(rtt, ctx->num_messages, sizeof(uint64_t), cmp_uint64);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < ctx->num_messages; i++)
+        sum += rtt[i];
+    
+    bench_emit_begin("spsc_ringbuffer");
+    bench_emit_str("test", "latency");
+    bench_emit_str("impl", "spsc");
+    bench_emit_uint("elem_size", ctx->elem_size);
+    bench_emit_uint("round_trips", ctx->num_messages);
+    bench_emit_double("rtt_avg_ns", (double) sum / ctx->num_messages);
+    bench_emit_uint("rtt_p50_ns", rtt[ctx->num_messages / 2]);
+    bench_emit_uint("rtt_p99_ns", rtt[ctx->num_messages * 99 / 100]);
+    bench_emit_uint("rtt_max_ns", rtt[ctx->num_messages - 1]);
+    bench_emit_end();
+    
+    spsc_rbuf_destroy(ctx->rb);
+    spsc_rbuf_destroy(ctx->reply);
+    free(rtt);
+    return 0;
+}
+
+int bench_spsc_ringbuffer(const struct bench_options *opt)
+{
+    static const size_t elem_sizes[] = { 8, 64, 256 };
+    struct bench_spsc_ctx ctx;
+    
+    for (size_t i = 0; i < sizeof(elem_sizes) / sizeof(elem_sizes[0]); i++) {
+        ctx.elem_size = elem_sizes[i];
+        ctx.num_messages = opt->full ? 50000000 : 2000000;
+        fprintf(stderr, "spsc: throughput, %zu bytes ...\n", ctx.elem_size);
+        if (run_throughput(&ctx, 4096) == -1)
+            return -1;
+        
+        ctx.num_messages = opt->full ? 1000000 : 100000;
+        fprintf(stderr, "spsc: latency, %zu bytes ...\n", ctx.elem_size);
+        if (run_latency(&ctx) == -1)
+            return -1;
+    }
+    
+    return 0;
+}
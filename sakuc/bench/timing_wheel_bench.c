@@ -0,0 +1,191 @@
+/* Benchmark of timing_wheel_t with 1M+ active timers.
+
+    schedule / cancel / expire - ns per operation, with random delays of up to
+                 2^20 ticks, half of the timers cancelled before expiring.
+    Compared with a binary min-heap (O(log n) insert and cancel), the sorted
+    structure the wheel replaces.
+
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include "../src/timing_wheel.h"
+#include "timing_wheel_bench.h"
+
+#define BENCH_TW_MAX_DELAY (1 << 20)
+
+struct bench_timer {
+    tw_timer_t timer;       // timing_wheel_t only.
+    uint64_t expires;       // heap only.
+    size_t heap_index;      // heap only.
+};
+
+static size_t bench_tw_fired = 0;
+
+static void bench_tw_expire(tw_timer_t *timer, void *arg)
+{
+    (void) timer; (void) arg;
+    ++ bench_tw_fired;
+}
+
+/* ## binary min-heap of timers by @expires, with @heap_index for O(log n) cancel. */
+struct bench_heap {
+    struct bench_timer **items;
+    size_t size;
+};
+
+static void heap_set(struct bench_heap *h, size_t i, struct bench_timer *t)
+{
+    h->items[i] = t;
+    t->heap_index = i;
+}
+
+static void heap_sift_up(struct bench_heap *h, size_t i)
+{
+    struct bench_timer *t = h->items[i];
+    while (i > 0 && h->items[(i - 1) / 2]->expires > t->expires) {
+        heap_set(h, i, h->items[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    heap_set(h, i, t);
+}
+
+static void heap_sift_down(struct bench_heap *h, size_t i)
+{
+    struct bench_timer *t = h->items[i];
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->size)
+            break;
+        if (child + 1 < h->size && h->items[child + 1]->expires < h->items[child]->expires)
+            ++ child;
+        if (h->items[child]->expires >= t->expires)
+            break;
+        heap_set(h, i, h->items[child]);
+        i = child;
+    }
+    heap_set(h, i, t);
+}
+
+static void heap_push(struct bench_heap *h, struct bench_timer *t)
+{
+    heap_set(h, h->size++, t);
+    heap_sift_up(h, h->size - 1);
+}
+
+static void heap_remove(struct bench_heap *h, size_t i)
+{
+    struct bench_timer *last = h->items[--h->size];
+    if (i == h->size)
+        return;
+    heap_set(h, i, last);
+    heap_sift_up(h, i);
+    heap_sift_down(h, last->heap_index);
+}
+
+static void emit_result(const char *impl, const char *op, size_t timers, size_t ops, uint64_t ns)
+{
+    bench_emit_begin("timing_wheel");
+    bench_emit_str("impl", impl);
+    bench_emit_str("op", op);
+    bench_emit_uint("active_timers", timers);
+    bench_emit_uint("ops", ops);
+    bench_emit_double("ns_op", ops ? (double) ns / ops : 0.0);
+    bench_emit_end();
+}
+
+static int run_wheel(struct bench_timer *timers, const uint64_t *delays, size_t n)
+{
+    timing_wheel_t *tw = tw_new(0);
+    if (!tw)
+        return -1;
+    
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        tw_timer_init(&timers[i].timer, bench_tw_expire, nullptr);
+        tw_schedule(tw, &timers[i].timer, delays[i]);
+    }
+    emit_result("timing_wheel", "schedule", n, n, bench_now_ns() - t0);
+    
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < n; i += 2)
+        tw_cancel(tw, &timers[i].timer);
+    emit_result("timing_wheel", "cancel", n, (n + 1) / 2, bench_now_ns() - t0);
+    
+    bench_tw_fired = 0;
+    size_t pending = tw_count(tw);
+    t0 = bench_now_ns();
+    size_t expired = tw_advance(tw, BENCH_TW_MAX_DELAY);
+    emit_result("timing_wheel", "expire", pending, expired, bench_now_ns() - t0);
+    
+    int ok = (expired == pending && bench_tw_fired == pending && tw_count(tw) == 0);
+    tw_destroy(tw);
+    return ok ? 0 : -1;
+}
+
+static int run_heap(struct bench_timer *timers, const uint64_t *delays, size_t n)
+{
+    struct bench_heap h = { .items = malloc(n * sizeof(struct bench_timer *)), .size = 0 };
+    if (!h.items)
+        return -1;
+    
+    uint64_t t0 = bench_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        timers[i].expires = delays[i];
+        heap_push(&h, &timers[i]);
+    }
+    emit_result("binary_heap", "schedule", n, n, bench_now_ns() - t0);
+    
+    t0 = bench_now_ns();
+    for (size_t i = 0; i < n; i += 2)
+        heap_remove(&h, timers[i].heap_index);
+    emit_result("binary_heap", "cancel", n, (n + 1) / 2, bench_now_ns() - t0);
+    
+    // tick by tick like the wheel, popping whatever is due.
+    size_t pending = h.size;
+    size_t expired = 0;
+    t0 = bench_now_ns();
+    for (uint64_t now = 1; now <= BENCH_TW_MAX_DELAY; now++) {
+        while (h.size > 0 && h.items[0]->expires <= now) {
+            heap_remove(&h, 0);
+            ++ expired;
+        }
+    }
+    emit_result("binary_heap", "expire", pending, expired, bench_now_ns() - t0);
+    
+    free(h.items);
+    return expired == pending ? 0 : -1;
+}
+
+int bench_timing_wheel(const struct bench_options *opt)
+{
+    static const size_t small_counts[] = { 1000000 };
+    static const size_t full_counts[] = { 1000000, 4000000 };
+    const size_t *counts = opt->full ? full_counts : small_counts;
+    size_t num_counts = opt->full ? 2 : 1;
+    
+    for (size_t c = 0; c < num_counts; c++) {
+        size_t n = counts[c];
+        struct bench_timer *timers = malloc(n * sizeof(struct bench_timer));
+        uint64_t *delays = malloc(n * sizeof(uint64_t));
+        if (!timers || !delays)
+            return -1;
+        
+        uint64_t seed = opt->seed;
+        for (size_t i = 0; i < n; i++)
+            delays[i] = 1 + bench_rand(&seed) % (BENCH_TW_MAX_DELAY - 1);
+        
+        fprintf(stderr, "timing_wheel: %zu timers ...\n", n);
+        if (run_wheel(timers, delays, n) == -1 || run_heap(timers, delays, n) == -1) {
+            free(timers); free(delays);
+            return -1;
+        }
+        free(timers);
+        free(delays);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,177 @@
+/* Fork/join scaling benchmark of ws_pool_t (work-stealing deques).
+
+    fib      - naive fibonacci, one task per call above a cut-off: many tiny tasks,
+               measures the spawn / pop / steal overhead.
+    tree_sum - recursive halving of a large array, leaves summing 4K elements: the
+               divide and conquer shape of a parallel directory scan.
+    Run with 1, 2, 4, ... workers up to the number of online cpus (at least 4), best
+    of BENCH_WS_RUNS runs. The speedup is relative to the 1-worker pool; "seq_ms" is
+    the plain recursion without any pool.
+    
+    History:
+        2026-10-19 - created.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "../src/ws_pool.h"
+#include "ws_pool_bench.h"
+
+#define BENCH_WS_FIB_CUTOFF 12
+#define BENCH_WS_LEAF_SIZE 4096
+#define BENCH_WS_RUNS 3
+
+struct bench_ws_task {
+    struct ws_task task;
+    // fib
+    int n;
+    // tree_sum
+    const uint64_t *data;
+    size_t len;
+    uint64_t result;
+};
+
+static uint64_t fib_seq(int n)
+{
+    return n < 2 ? (uint64_t) n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+static void fib_run(struct ws_worker *w, struct ws_task *task)
+{
+    struct bench_ws_task *t = (struct bench_ws_task *) task;
+    if (t->n < BENCH_WS_FIB_CUTOFF) {
+        t->result = fib_seq(t->n);
+        return;
+    }
+    
+    struct bench_ws_task left = { .task.run = fib_run, .n = t->n - 1 };
+    struct bench_ws_task right = { .task.run = fib_run, .n = t->n - 2 };
+    struct ws_group group = WS_GROUP_INIT;
+    if (ws_pool_spawn(w, &group, &left.task) == -1)
+        fib_run(w, &left.task);
+    fib_run(w, &right.task);
+    ws_worker_wait(w, &group);
+    t->result = left.result + right.result;
+}
+
+static uint64_t sum_seq(const uint64_t *data, size_t len)
+{
+    if (len <= BENCH_WS_LEAF_SIZE) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < len; i++)
+            sum += data[i] * data[i] % 1000003;
+        return sum;
+    }
+    return sum_seq(data, len / 2) + sum_seq(data + len / 2, len - len / 2);
+}
+
+static void sum_run(struct ws_worker *w, struct ws_task *task)
+{
+    struct bench_ws_task *t = (struct bench_ws_task *) task;
+    if (t->len <= BENCH_WS_LEAF_SIZE) {
+        t->result = sum_seq(t->data, t->len);
+        return;
+    }
+    
+    struct bench_ws_task left = { .task.run = sum_run, .data = t->data, .len = t->len / 2 };
+    struct bench_ws_task right = { .task.run = sum_run, .data = t->data + t->len / 2,
+                                   .len = t->len - t->len / 2 };
+    struct ws_group group = WS_GROUP_INIT;
+    if (ws_pool_spawn(w, &group, &left.task) == -1)
+        sum_run(w, &left.task);
+    sum_run(w, &right.task);
+    ws_worker_wait(w, &group);
+    t->result = left.result + right.result;
+}
+
+/* run @root on a pool of @num_workers, -1 returned if failed or @expected is wrong. */
+static int run_case(const char *workload, struct bench_ws_task *root, uint64_t expected,
+                    size_t num_workers, double seq_ms, double *base_ms)
+{
+    ws_pool_t *pool = ws_pool_new(num_workers, 64);
+    if (!pool)
+        return -1;
+    
+    // best of BENCH_WS_RUNS, the first one also wakes the workers up.
+    double ms = 0;
+    for (int run = 0; run < BENCH_WS_RUNS; run++) {
+        struct ws_group group = WS_GROUP_INIT;
+        root->result = 0;
+        uint64_t t0 = bench_now_ns();
+        if (ws_pool_submit(pool, &group, &root->task) == -1) {
+            ws_pool_destroy(pool);
+            return -1;
+        }
+        ws_pool_wait(pool, &group);
+        double run_ms = (bench_now_ns() - t0) / 1e6;
+        if (run == 0 || run_ms < ms)
+            ms = run_ms;
+    }
+    
+    size_t executed = 0, steals = 0;
+    for (size_t i = 0; i < num_workers; i++) {
+        executed += pool->workers[i].executed;
+        steals += pool->workers[i].steals;
+    }
+    ws_pool_destroy(pool);
+    if (root->result != expected)
+        return -1;
+    
+    if (num_workers == 1)
+        *base_ms = ms;
+    bench_emit_begin("ws_pool");
+    bench_emit_str("workload", workload);
+    bench_emit_uint("workers", num_workers);
+    bench_emit_uint("tasks", executed / BENCH_WS_RUNS);
+    bench_emit_uint("steals", steals / BENCH_WS_RUNS);
+    bench_emit_double("seq_ms", seq_ms);
+    bench_emit_double("ms", ms);
+    bench_emit_double("speedup", ms > 0 ? *base_ms / ms : 0);
+    bench_emit_end();
+    return 0;
+}
+
+int bench_ws_pool(const struct bench_options *opt)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_workers = cpus > 4 ? (size_t) cpus : 4;
+    int fib_n = opt->full ? 40 : 34;
+    size_t sum_len = opt->full ? (64u << 20) : (8u << 20);
+    
+    uint64_t *data = malloc(sum_len * sizeof(uint64_t));
+    if (!data)
+        return -1;
+    uint64_t seed = opt->seed;
+    for (size_t i = 0; i < sum_len; i++)
+        data[i] = bench_rand(&seed);
+    
+    uint64_t t0 = bench_now_ns();
+    uint64_t fib_expected = fib_seq(fib_n);
+    double fib_seq_ms = (bench_now_ns() - t0) / 1e6;
+    t0 = bench_now_ns();
+    uint64_t sum_expected = sum_seq(data, sum_len);
+    double sum_seq_ms = (bench_now_ns() - t0) / 1e6;
+    
+    double base_ms = 0;
+    for (size_t workers = 1; workers <= max_workers; workers <<= 1) {
+        fprintf(stderr, "ws_pool: fib(%d), %zu workers (%ld cpus) ...\n", fib_n, workers, cpus);
+        struct bench_ws_task root = { .task.run = fib_run, .n = fib_n };
+        if (run_case("fib", &root, fib_expected, workers, fib_seq_ms, &base_ms) == -1)
+            goto bench_ws_pool_failed;
+    }
+    for (size_t workers = 1; workers <= max_workers; workers <<= 1) {
+        fprintf(stderr, "ws_pool: tree_sum(%zu), %zu workers ...\n", sum_len, workers);
+        struct bench_ws_task root = { .task.run = sum_run, .data = data, .len = sum_len };
+        if (run_case("tree_sum", &root, sum_expected, workers, sum_seq_ms, &base_ms) == -1)
+            goto bench_ws_pool_failed;
+    }
+    
+    free(data);
+    return 0;
+
+bench_ws_pool_failed:
+    free(data);
+    return -1;
+}
@@ -1,6 +1,19 @@
 #include <stdio.h>
 #include "test/ringbuffer_test.h"
+#include "test/spsc_ringbuffer_test.h"
+#include "test/mpmc_ringbuffer_test.h"
+#include "test/typed_ringbuffer_test.h"
+#include "test/record_ringbuffer_test.h"
+#include "test/shm_ringbuffer_test.h"
+#include "test/broadcast_ringbuffer_test.h"
+#include "test/snapshot_ringbuffer_test.h"
+#include "test/timing_wheel_test.h"
 #include "test/deque_test.h"
+#include "test/typed_deque_test.h"
+#include "test/ws_deque_test.h"
+#include "test/ws_pool_test.h"
+#include "test/concurrent_deque_test.h"
+#include "test/sliding_window_test.h"
 #include "test/multi_pattern_match_test.h"
 
 int main()
@@ -11,12 +24,77 @@ int main()
         printf("*** FAILED! - ringbuffer\n");
     else
         printf("* PASSED! - ringbuffer\n");
+    
+    if (test_spsc_ringbuffer() == -1)
+        printf("*** FAILED! - spsc ringbuffer\n");
+    else
+        printf("* PASSED! - spsc ringbuffer\n");
+    
+    if (test_mpmc_ringbuffer() == -1)
+        printf("*** FAILED! - mpmc ringbuffer\n");
+    else
+        printf("* PASSED! - mpmc ringbuffer\n");
+    
+    if (test_typed_ringbuffer() == -1)
+        printf("*** FAILED! - typed ringbuffer\n");
+    else
+        printf("* PASSED! - typed ringbuffer\n");
+    
+    if (test_record_ringbuffer() == -1)
+        printf("*** FAILED! - record ringbuffer\n");
+    else
+        printf("* PASSED! - record ringbuffer\n");
+    
+    if (test_shm_ringbuffer() == -1)
+        printf("*** FAILED! - shm ringbuffer\n");
+    else
+        printf("* PASSED! - shm ringbuffer\n");
+    
+    if (test_broadcast_ringbuffer() == -1)
+        printf("*** FAILED! - broadcast ringbuffer\n");
+    else
+        printf("* PASSED! - broadcast ringbuffer\n");
+    
+    if (test_snapshot_ringbuffer() == -1)
+        printf("*** FAILED! - snapshot ringbuffer\n");
+    else
+        printf("* PASSED! - snapshot ringbuffer\n");
+    
+    if (test_timing_wheel() == -1)
+        printf("*** FAILED! - timing wheel\n");
+    else
+        printf("* PASSED! - timing wheel\n");
         
     if (test_deque() == -1)
         printf("*** FAILED! - deque\n");
     else
         printf("* PASSED! - deque\n");
     
+    if (test_typed_deque() == -1)
+        printf("*** FAILED! - typed deque\n");
+    else
+        printf("* PASSED! - typed deque\n");
+    
+    if (test_ws_deque() == -1)
+        printf("*** FAILED! - work-stealing deque\n");
+    else
+        printf("* PASSED! - work-stealing deque\n");
+    
+    if (test_ws_pool() == -1)
+        printf("*** FAILED! - work-stealing pool\n");
+    else
+        printf("* PASSED! - work-stealing pool\n");
+    
+    if (test_concurrent_deque() == -1)
+        printf("*** FAILED! - concurrent deque\n");
+    else
+        printf("* PASSED! - concurrent deque\n");
+    
+    if (test_sliding_window() == -1)
+        printf("*** FAILED! - sliding window\n");
+    else
+        printf("* PASSED! - sliding window\n");
+    
     if (test_multi_pattern_match() == -1)
         printf("*** FAILED! - multi-pattern match\n");
     else
@@ -0,0 +1,230 @@
+// 2026-10-19 - single-producer/multi-consumer broadcast ringbuffer (disruptor-style).
+
+#include "broadcast_ringbuffer.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+enum {
+    BCAST_CURSOR_FREE = 0,
+    BCAST_CURSOR_CLAIMED = 1,   // being subscribed, ignored by the producer.
+    BCAST_CURSOR_ACTIVE = 2,
+};
+
+#define bcast_slot_(rb, seq) ((char *)(rb)->buffer + ((seq) & (rb)->mask) * (rb)->slot_size)
+#define bcast_stamp_(slot) ((size_t *)(slot))
+#define bcast_data_(slot) ((char *)(slot) + sizeof(size_t))
+
+broadcast_ringbuffer_t* bcast_rbuf_new(size_t capacity, size_t elem_size,
+                                       size_t max_consumers, int overwrite)
+{
+    if (capacity == 0 || elem_size == 0 || max_consumers == 0 || max_consumers > INT32_MAX)
+        return nullptr;
+    
+    size_t pow2 = 1;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    size_t slot_size = (sizeof(size_t) + elem_size + sizeof(size_t) - 1)
+                       / sizeof(size_t) * sizeof(size_t);
+    
+    broadcast_ringbuffer_t *rb = (broadcast_ringbuffer_t *)
+        osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, sizeof(broadcast_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    rb->buffer = osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, pow2 * slot_size);
+    rb->cursors = (struct bcast_rbuf_cursor_ *) osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,
+                    max_consumers * sizeof(struct bcast_rbuf_cursor_));
+    if (!rb->buffer || !rb->cursors) {
+        if (rb->buffer)
+            osal_mem_aligned_free(rb->buffer);
+        if (rb->cursors)
+            osal_mem_aligned_free(rb->cursors);
+        osal_mem_aligned_free(rb);
+        return nullptr;
+    }
+    
+    rb->capacity = pow2; rb->mask = pow2 - 1;
+    rb->block_size = elem_size;
+    rb->slot_size = slot_size;
+    rb->max_consumers = max_consumers;
+    rb->overwrite = overwrite ? TRUE : FALSE;
+    rb->head = rb->gate = 0;
+    
+    for (size_t i=0; i < pow2; i++)
+        *bcast_stamp_(bcast_slot_(rb, i)) = 0;
+    for (size_t i=0; i < max_consumers; i++) {
+        rb->cursors[i].seq = 0;
+        rb->cursors[i].state = BCAST_CURSOR_FREE;
+    }
+    return rb;
+}
+
+int bcast_rbuf_subscribe(broadcast_ringbuffer_t *rb)
+{
+    if (!rb)
+        return -1;
+    
+    for (size_t i=0; i < rb->max_consumers; i++) {
+        struct bcast_rbuf_cursor_ *cursor = &rb->cursors[i];
+        int expected = BCAST_CURSOR_FREE;
+        if (!osal_atomic_cas_weak(&cursor->state, &expected, BCAST_CURSOR_CLAIMED))
+            continue;
+        
+        /*  A producer which scanned the cursors before we became active may still
+            publish up to (its old gate + capacity), and its old gate <= head as
+            read below. So start at the head read *after* activation: the slot of
+            that sequence cannot be overwritten before the producer sees us.
+         */
+        osal_atomic_store_release(&cursor->seq, osal_atomic_load_acquire(&rb->head));
+        osal_atomic_store_release(&cursor->state, BCAST_CURSOR_ACTIVE);
+        osal_atomic_fence_seq_cst();
+        osal_atomic_store_release(&cursor->seq, osal_atomic_load_acquire(&rb->head));
+        return (int) i;
+    }
+    return -1;
+}
+
+int bcast_rbuf_unsubscribe(broadcast_ringbuffer_t *rb, int id)
+{
+    if (!rb || id < 0 || (size_t) id >= rb->max_consumers
+        || osal_atomic_load_acquire(&rb->cursors[id].state) != BCAST_CURSOR_ACTIVE)
+        return -1;
+    
+    osal_atomic_store_release(&rb->cursors[id].state, BCAST_CURSOR_FREE);
+    return 0;
+}
+
+/* the slowest active consumer's cursor, @head if there is none. */
+static size_t bcast_rbuf_min_cursor_(broadcast_ringbuffer_t *rb, size_t head)
+{
+    size_t min = head;
+    osal_atomic_fence_seq_cst(); // pairs with #bcast_rbuf_subscribe.
+    for (size_t i=0; i < rb->max_consumers; i++) {
+        if (osal_atomic_load_acquire(&rb->cursors[i].state) != BCAST_CURSOR_ACTIVE)
+            continue;
+        size_t seq = osal_atomic_load_acquire(&rb->cursors[i].seq);
+        if (head - seq > head - min)
+            min = seq;
+    }
+    return min;
+}
+
+int bcast_rbuf_push_back(broadcast_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || !data || len != rb->block_size)
+        return -1;
+    
+    size_t head = rb->head; // only the producer writes it.
+    
+    // refresh the cached slowest consumer only when we seem to be full.
+    if (!rb->overwrite && head - rb->gate >= rb->capacity) {
+        rb->gate = bcast_rbuf_min_cursor_(rb, head);
+        if (head - rb->gate >= rb->capacity)
+            return -1;
+    }
+    
+    char *slot = bcast_slot_(rb, head);
+    if (rb->overwrite) {
+        // readers of the previous lap detect the overwrite by the stamp, refer to seqlock.
+        osal_atomic_store_relaxed(bcast_stamp_(slot), 0);
+        osal_atomic_fence_release();
+    }
+    osal_memcpy(bcast_data_(slot), data, len);
+    osal_atomic_store_release(bcast_stamp_(slot), head + 1);
+    osal_atomic_store_release(&rb->head, head + 1);
+    return 0;
+}
+
+/* consumer @id is valid and active. */
+#define bcast_valid_id_(rb, id) \
+    ((rb) && (id) >= 0 && (size_t) (id) < (rb)->max_consumers \
+     && osal_atomic_load_acquire(&(rb)->cursors[id].state) == BCAST_CURSOR_ACTIVE)
+
+void *bcast_rbuf_pop_front(broadcast_ringbuffer_t *rb, int id, void *pop_value,
+                           size_t len, size_t *lost)
+{
+    if (lost)
+        *lost = 0;
+    if (!bcast_valid_id_(rb, id) || !pop_value || len != rb->block_size)
+        return nullptr;
+    
+    struct bcast_rbuf_cursor_ *cursor = &rb->cursors[id];
+    size_t seq = cursor->seq; // only this consumer writes it (once subscribed).
+    size_t skipped = 0;
+    
+    for (;;) {
+        size_t head = osal_atomic_load_acquire(&rb->head);
+        if (seq == head)
+            break;
+        if (head - seq > rb->capacity) {
+            // lapped (only when @overwrite), jump to the oldest element still there.
+            skipped += head - rb->capacity - seq;
+            seq = head - rb->capacity;
+        }
+        
+        char *slot = bcast_slot_(rb, seq);
+        size_t stamp = osal_atomic_load_acquire(bcast_stamp_(slot));
+        if (stamp == seq + 1) {
+            osal_memcpy(pop_value, bcast_data_(slot), len);
+            osal_atomic_fence_acquire();
+            if (osal_atomic_load_relaxed(bcast_stamp_(slot)) == stamp) {
+                osal_atomic_store_release(&cursor->seq, seq + 1);
+                if (lost)
+                    *lost = skipped;
+                return pop_value;
+            }
+        }
+        // overwritten meanwhile, the producer is at least one lap ahead: retry.
+        skipped += 1;
+        seq += 1;
+    }
+    
+    osal_atomic_store_release(&cursor->seq, seq);
+    if (lost)
+        *lost = skipped;
+    return nullptr;
+}
+
+const void *bcast_rbuf_peek_front(broadcast_ringbuffer_t *rb, int id)
+{
+    if (!bcast_valid_id_(rb, id) || rb->overwrite)
+        return nullptr;
+    
+    size_t seq = rb->cursors[id].seq;
+    if (seq == osal_atomic_load_acquire(&rb->head))
+        return nullptr;
+    return bcast_data_(bcast_slot_(rb, seq));
+}
+
+int bcast_rbuf_consume_front(broadcast_ringbuffer_t *rb, int id)
+{
+    if (!bcast_valid_id_(rb, id) || rb->overwrite)
+        return -1;
+    
+    struct bcast_rbuf_cursor_ *cursor = &rb->cursors[id];
+    if (cursor->seq == osal_atomic_load_acquire(&rb->head))
+        return -1;
+    osal_atomic_store_release(&cursor->seq, cursor->seq + 1);
+    return 0;
+}
+
+size_t bcast_rbuf_length(broadcast_ringbuffer_t *rb, int id)
+{
+    if (!bcast_valid_id_(rb, id))
+        return 0;
+    
+    size_t length = osal_atomic_load_acquire(&rb->head)
+                    - osal_atomic_load_acquire(&rb->cursors[id].seq);
+    return length > rb->capacity ? rb->capacity : length;
+}
+
+int bcast_rbuf_destroy(broadcast_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->buffer))
+        return -1;
+    
+    osal_mem_aligned_free(rb->cursors);
+    osal_mem_aligned_free(rb->buffer);
+    osal_mem_aligned_free(rb);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// 2026-10-19 - single-producer/multi-consumer broadcast ringbuffer (disruptor-style).
+
+#ifndef SAKUC_BROADCAST_RINGBUFFER_H_
+#define SAKUC_BROADCAST_RINGBUFFER_H_
+
+#include "common_defs.h"
+
+/*  Every element pushed is seen by every subscribed consumer: the producer writes
+    it once, and each consumer follows the published sequence with its own cursor.
+    
+    Every slot holds a @stamp followed by @block_size bytes of data:
+    stamp == seq + 1         - slot holds element @seq (free-running sequence).
+    stamp == 0               - slot is being overwritten by the producer.
+ */
+struct bcast_rbuf_cursor_ {
+    size_t seq;     // next sequence to be read by this consumer.
+    int state;      // BCAST_CURSOR_FREE / _CLAIMED / _ACTIVE.
+    char pad[SAKUC_CACHE_LINE_SIZE - sizeof(size_t) - sizeof(int)];
+};
+
+typedef struct broadcast_ringbuffer {
+    // read-only after #bcast_rbuf_new.
+    size_t capacity;        // power of 2.
+    size_t mask;            // capacity - 1.
+    size_t block_size;
+    size_t slot_size;       // sizeof(size_t) + block_size, rounded up to sizeof(size_t).
+    size_t max_consumers;
+    void *buffer;
+    struct bcast_rbuf_cursor_ *cursors;    // @max_consumers of them.
+    int overwrite;          // TRUE - never wait for slow consumers, refer to #bcast_rbuf_new.
+    char pad0[SAKUC_CACHE_LINE_SIZE - 5 * sizeof(size_t) - 2 * sizeof(void *) - sizeof(int)];
+    
+    size_t head;            // next sequence to be published, written by the producer.
+    size_t gate;            // producer private: cached slowest consumer's cursor.
+    char pad1[SAKUC_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+} broadcast_ringbuffer_t;
+
+/*  New a broadcast ringbuffer, @capacity is rounded up to power of 2, at most
+    @max_consumers consumers may be subscribed at the same time.
+    If @overwrite is FALSE, the producer gates on the slowest consumer (push fails
+    when it would overwrite an element not read by everyone). If TRUE, the producer
+    never waits and a lagging consumer skips what was overwritten, reporting the loss.
+    nullptr returned if failed.
+ */
+extern broadcast_ringbuffer_t* bcast_rbuf_new(size_t capacity, size_t elem_size,
+                                              size_t max_consumers, int overwrite);
+
+/*  Subscribe a consumer (any thread), it sees the elements pushed from now on.
+    Return the consumer id used below, -1 if failed or too many consumers.
+ */
+extern int bcast_rbuf_subscribe(broadcast_ringbuffer_t *rb);
+
+/*  The consumer @id no longer holds the producer back. -1 returned if failed. */
+extern int bcast_rbuf_unsubscribe(broadcast_ringbuffer_t *rb, int id);
+
+/*  Publish @data (with length @len) to all consumers, producer thread only.
+    -1 returned if failed, or if full (the slowest consumer is @capacity behind)
+    and not @overwrite. Elements pushed while nobody is subscribed are dropped.
+ */
+extern int bcast_rbuf_push_back(broadcast_ringbuffer_t *rb, const void *data, size_t len);
+
+/*  Copy the next element of consumer @id to @pop_value (buffer with length @len which
+    equals to @rb->block_size), only the thread owning @id may call it.
+    @lost - optional, set to the number of elements this consumer missed because
+    they were overwritten (always 0 if not @overwrite).
+    nullptr returned if there is nothing new.
+ */
+extern void *bcast_rbuf_pop_front(broadcast_ringbuffer_t *rb, int id, void *pop_value,
+                                  size_t len, size_t *lost);
+
+/*  Zero-copy read for a gating (not @overwrite) @rb: the next element of consumer @id
+    in place, valid until #bcast_rbuf_consume_front. nullptr returned if nothing new.
+ */
+extern const void *bcast_rbuf_peek_front(broadcast_ringbuffer_t *rb, int id);
+extern int bcast_rbuf_consume_front(broadcast_ringbuffer_t *rb, int id);
+
+/* elements not read yet by consumer @id, approximate when used concurrently. */
+extern size_t bcast_rbuf_length(broadcast_ringbuffer_t *rb, int id);
+
+/* -1 returned if failed. No thread may use @rb any more. */
+extern int bcast_rbuf_destroy(broadcast_ringbuffer_t *rb);
+
+#endif // SAKUC_BROADCAST_RINGBUFFER_H_
@@ -0,0 +1,72 @@
+#ifndef COMMON_ATOMIC_DEFS_H_
+#define COMMON_ATOMIC_DEFS_H_
+
+/* osal atomic operations, mapped to the gcc/clang __atomic builtins so that the
+   code still compiles with -std=c99 (no <stdatomic.h> required).
+   Override them before including this file when porting to another compiler.
+ */
+
+#ifndef osal_atomic_load_relaxed
+#define osal_atomic_load_relaxed(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#endif
+
+#ifndef osal_atomic_load_acquire
+#define osal_atomic_load_acquire(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif
+
+#ifndef osal_atomic_store_relaxed
+#define osal_atomic_store_relaxed(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#endif
+
+#ifndef osal_atomic_store_release
+#define osal_atomic_store_release(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#endif
+
+#ifndef osal_atomic_fetch_add
+#define osal_atomic_fetch_add(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+#ifndef osal_atomic_exchange
+#define osal_atomic_exchange(ptr, val) __atomic_exchange_n((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+// weak CAS, @expected (pointer) is updated with the current value if failed.
+#ifndef osal_atomic_cas_weak
+#define osal_atomic_cas_weak(ptr, expected, desired)                        \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), 1,            \
+                                __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+#endif
+
+#ifndef osal_atomic_fetch_sub
+#define osal_atomic_fetch_sub(ptr, val) __atomic_fetch_sub((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+// strong sequentially consistent CAS, for algorithms proven under seq_cst (eg. Chase-Lev).
+#ifndef osal_atomic_cas_strong_seq_cst
+#define osal_atomic_cas_strong_seq_cst(ptr, expected, desired)              \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), 0,            \
+                                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+#endif
+
+#ifndef osal_atomic_fence_acquire
+#define osal_atomic_fence_acquire() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#endif
+
+#ifndef osal_atomic_fence_release
+#define osal_atomic_fence_release() __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+#ifndef osal_atomic_fence_seq_cst
+#define osal_atomic_fence_seq_cst() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+// hint the cpu that we are inside a spin-wait loop.
+#ifndef osal_cpu_relax
+#if defined(__i386__) || defined(__x86_64__)
+#define osal_cpu_relax() __builtin_ia32_pause()
+#else
+#define osal_cpu_relax() do {} while (__LINE__ == -1)
+#endif
+#endif
+
+#endif // COMMON_ATOMIC_DEFS_H_
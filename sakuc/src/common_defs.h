@@ -16,4 +16,13 @@ typedef unsigned char uint8;
 
 #define nullptr 0
 
+// used to keep data written by different threads on different cache lines.
+#ifndef SAKUC_CACHE_LINE_SIZE
+#define SAKUC_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef SAKUC_PAGE_SIZE
+#define SAKUC_PAGE_SIZE 4096
+#endif
+
 #endif // COMMON_DEFS_H_
@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 /* osal - operating system abstract layer (a name adopted from TI z-stack)
  */
@@ -23,5 +24,30 @@
 #define osal_memcpy(dst, src, size) memcpy((dst), (src), (size))
 #endif
 
+#ifndef osal_memset
+#define osal_memset(dst, val, size) memset((dst), (val), (size))
+#endif
+
+/* @align - power of 2. Memory returned must be freed by osal_mem_aligned_free.
+   Implemented on top of osal_mem_alloc (over-allocate, the raw pointer is stored
+   just before the aligned block), so it is available wherever malloc is.
+ */
+#ifndef osal_mem_aligned_alloc
+#define osal_mem_aligned_alloc(align, size) osal_mem_aligned_alloc_((align), (size))
+#define osal_mem_aligned_free(block) osal_mem_free(((void **)(block))[-1])
+
+static inline void *osal_mem_aligned_alloc_(size_t align, size_t size)
+{
+    char *raw = (char *) osal_mem_alloc(size + align - 1 + sizeof(void *));
+    if (!raw)
+        return NULL;
+
+    uintptr_t aligned = ((uintptr_t) (raw + sizeof(void *)) + align - 1)
+                        & ~(uintptr_t) (align - 1);
+    ((void **) aligned)[-1] = raw;
+    return (void *) aligned;
+}
+#endif
+
 #endif // COMMON_MEMORY_MANAGEMENT_DEFS_H_
 
@@ -0,0 +1,234 @@
+// 2026-10-19 - unbounded two-lock concurrent deque, built of sakuc_deque_t's blocks.
+
+#define _GNU_SOURCE // clock_gettime, pthread_condattr_setclock
+
+#include <errno.h>
+#include <time.h>
+#include "concurrent_deque.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+/* a block from @spare, or a new one, with [start, end) set to [@pos, @pos). */
+static struct sakuc_sub_deque_ *sakuc_cdeque_block_new_(sakuc_cdeque_t *dq, size_t pos)
+{
+    struct sakuc_sub_deque_ *sub = osal_atomic_exchange(&dq->spare, nullptr);
+    if (!sub) {
+        sub = osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,
+                                     sakuc_sub_deque_bytes(dq->sub_deque_size, dq->elem_size));
+        if (!sub)
+            return nullptr;
+    }
+    sub->next = sub->prev = nullptr;
+    sub->length = 0;
+    sub->size = dq->sub_deque_size;
+    sub->start = sub->end = pos;
+    return sub;
+}
+
+/* keep @sub as the spare block, or free it if there is one already. */
+static void sakuc_cdeque_block_retire_(sakuc_cdeque_t *dq, struct sakuc_sub_deque_ *sub)
+{
+    struct sakuc_sub_deque_ *expected = nullptr;
+    if (!osal_atomic_cas_weak(&dq->spare, &expected, sub))
+        osal_mem_aligned_free(sub);
+}
+
+/* with @head_lock held. -1 returned if empty. */
+static int sakuc_cdeque_pop_locked_(sakuc_cdeque_t *dq, void *data)
+{
+    struct sakuc_sub_deque_ *head = dq->head_block;
+    for (;;) {
+        size_t end = osal_atomic_load_acquire(&head->end);
+        if (head->start < end)
+            break;
+        if (end < dq->sub_deque_size)
+            return -1; // producers are still filling it.
+    
+        struct sakuc_sub_deque_ *next = osal_atomic_load_acquire(&head->next);
+        if (!next)
+            return -1; // full and consumed, the next one is not linked yet.
+        // @head is not the tail any more, no producer would touch it.
+        dq->head_block = next;
+        sakuc_cdeque_block_retire_(dq, head);
+        head = next;
+    }
+    
+    osal_memcpy(data, head->data_buffer + head->start * dq->elem_size, dq->elem_size);
+    ++ head->start;
+    osal_atomic_store_relaxed(&dq->popped, dq->popped + 1);
+    return 0;
+}
+
+sakuc_cdeque_t *sakuc_cdeque_new(size_t sub_deque_size, size_t elem_size)
+{
+    if (sub_deque_size == 0 || elem_size == 0)
+        return nullptr;
+    
+    sakuc_cdeque_t *dq = (sakuc_cdeque_t *) osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,
+                                                                   sizeof(sakuc_cdeque_t));
+    if (!dq)
+        return nullptr;
+    
+    dq->sub_deque_size = sub_deque_size;
+    dq->elem_size = elem_size;
+    dq->spare = nullptr;
+    dq->popped = dq->pushed = dq->num_waiters = 0;
+    dq->head_block = dq->tail_block = sakuc_cdeque_block_new_(dq, 0);
+    if (!dq->head_block) {
+        osal_mem_aligned_free(dq);
+        return nullptr;
+    }
+    
+    // timeouts are measured on the monotonic clock, immune to wall clock changes.
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&dq->not_empty, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&dq->head_lock, nullptr);
+    pthread_mutex_init(&dq->tail_lock, nullptr);
+    return dq;
+}
+
+int sakuc_cdeque_push_back(sakuc_cdeque_t *dq, const void *data, size_t len)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return -1;
+    
+    pthread_mutex_lock(&dq->tail_lock);
+    struct sakuc_sub_deque_ *tail = dq->tail_block;
+    if (tail->end == dq->sub_deque_size) {
+        struct sakuc_sub_deque_ *sub = sakuc_cdeque_block_new_(dq, 0);
+        if (!sub) {
+            pthread_mutex_unlock(&dq->tail_lock);
+            return -1;
+        }
+        osal_atomic_store_release(&tail->next, sub);
+        dq->tail_block = tail = sub;
+    }
+    osal_memcpy(tail->data_buffer + tail->end * len, data, len);
+    osal_atomic_store_release(&tail->end, tail->end + 1);
+    osal_atomic_store_relaxed(&dq->pushed, dq->pushed + 1);
+    pthread_mutex_unlock(&dq->tail_lock);
+    
+    // pairs with the fence of #sakuc_cdeque_pop_front_timed: either the waiter sees
+    // the element, or we see the waiter.
+    osal_atomic_fence_seq_cst();
+    if (osal_atomic_load_relaxed(&dq->num_waiters) > 0) {
+        pthread_mutex_lock(&dq->head_lock);
+        pthread_cond_signal(&dq->not_empty);
+        pthread_mutex_unlock(&dq->head_lock);
+    }
+    return 0;
+}
+
+int sakuc_cdeque_push_front(sakuc_cdeque_t *dq, const void *data, size_t len)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return -1;
+    
+    pthread_mutex_lock(&dq->head_lock);
+    struct sakuc_sub_deque_ *head = dq->head_block;
+    if (head->start == 0) {
+        // a full block of its own, never the tail: producers won't see it.
+        struct sakuc_sub_deque_ *sub = sakuc_cdeque_block_new_(dq, dq->sub_deque_size);
+        if (!sub) {
+            pthread_mutex_unlock(&dq->head_lock);
+            return -1;
+        }
+        sub->next = head;
+        dq->head_block = head = sub;
+    }
+    -- head->start;
+    osal_memcpy(head->data_buffer + head->start * len, data, len);
+    osal_atomic_store_relaxed(&dq->popped, dq->popped - 1);
+    
+    // only a consumer could be waiting, wake it up as it won't see a producer's signal.
+    if (dq->num_waiters > 0)
+        pthread_cond_signal(&dq->not_empty);
+    pthread_mutex_unlock(&dq->head_lock);
+    return 0;
+}
+
+int sakuc_cdeque_pop_front(sakuc_cdeque_t *dq, void *data, size_t len)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return -1;
+    
+    pthread_mutex_lock(&dq->head_lock);
+    int ret = sakuc_cdeque_pop_locked_(dq, data);
+    pthread_mutex_unlock(&dq->head_lock);
+    return ret;
+}
+
+int sakuc_cdeque_pop_front_timed(sakuc_cdeque_t *dq, void *data, size_t len,
+                                 long timeout_ms)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return -1;
+    
+    pthread_mutex_lock(&dq->head_lock);
+    int ret = sakuc_cdeque_pop_locked_(dq, data);
+    if (ret == 0 || timeout_ms == 0) {
+        pthread_mutex_unlock(&dq->head_lock);
+        return ret;
+    }
+    
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        ++ deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    osal_atomic_fetch_add(&dq->num_waiters, 1);
+    for (;;) {
+        osal_atomic_fence_seq_cst();
+        ret = sakuc_cdeque_pop_locked_(dq, data);
+        if (ret == 0)
+            break;
+        if (timeout_ms < 0)
+            pthread_cond_wait(&dq->not_empty, &dq->head_lock);
+        else if (pthread_cond_timedwait(&dq->not_empty, &dq->head_lock, &deadline) == ETIMEDOUT) {
+            ret = sakuc_cdeque_pop_locked_(dq, data);
+            break;
+        }
+    }
+    osal_atomic_fetch_sub(&dq->num_waiters, 1);
+    pthread_mutex_unlock(&dq->head_lock);
+    return ret;
+}
+
+size_t sakuc_cdeque_length(sakuc_cdeque_t *dq)
+{
+    if (!dq)
+        return 0;
+    
+    size_t popped = osal_atomic_load_relaxed(&dq->popped);
+    size_t pushed = osal_atomic_load_relaxed(&dq->pushed);
+    size_t length = pushed - popped;
+    return length > (SIZE_MAX >> 1) ? 0 : length; // "negative", raced with the other side.
+}
+
+int sakuc_cdeque_destroy(sakuc_cdeque_t *dq)
+{
+    if (!dq)
+        return -1;
+    
+    struct sakuc_sub_deque_ *sub = dq->head_block;
+    while (sub) {
+        struct sakuc_sub_deque_ *next = sub->next;
+        osal_mem_aligned_free(sub);
+        sub = next;
+    }
+    if (dq->spare)
+        osal_mem_aligned_free(dq->spare);
+    
+    pthread_mutex_destroy(&dq->tail_lock);
+    pthread_mutex_destroy(&dq->head_lock);
+    pthread_cond_destroy(&dq->not_empty);
+    osal_mem_aligned_free(dq);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// 2026-10-19 - unbounded two-lock concurrent deque, built of sakuc_deque_t's blocks.
+
+#ifndef SAKUC_CONCURRENT_DEQUE_H_
+#define SAKUC_CONCURRENT_DEQUE_H_
+
+#include <pthread.h>
+#include "common_defs.h"
+#include "deque.h"
+
+/*  Michael & Scott's two-lock queue, with blocks of elements instead of one node per
+    element:
+    
+        @head_block -> [start .. end) -> ... -> [0 .. end) <- @tail_block
+    
+    Producers take @tail_lock, copy the element at @tail_block->end and publish it by
+    a release store of @end; a full tail block gets a successor linked by a release
+    store of @next. Consumers take @head_lock, and read up to the acquired @end of
+    @head_block, moving on once it is full and consumed. A block is touched by
+    producers only while it is the tail, so both sides never wait for each other.
+    
+    #sakuc_cdeque_push_front runs on the consumers' side (eg. putting an element back),
+    there is no pop_back: the back end belongs to producers.
+    
+    The last retired block is kept in @spare for the next new one, so that a steady
+    flow needs no malloc / free.
+ */
+typedef struct sakuc_cdeque
+{
+    // read-only after #sakuc_cdeque_new.
+    size_t sub_deque_size;
+    size_t elem_size;
+    struct sakuc_sub_deque_ *spare;     // exchanged atomically by both sides.
+    char pad0[SAKUC_CACHE_LINE_SIZE];   // keep the two sides on their own cache lines.
+    
+    // consumers' side.
+    pthread_mutex_t head_lock;
+    pthread_cond_t not_empty;           // with @head_lock, for #sakuc_cdeque_pop_front_timed.
+    struct sakuc_sub_deque_ *head_block;
+    size_t popped;                      // minus the ones pushed to the front.
+    size_t num_waiters;
+    char pad1[SAKUC_CACHE_LINE_SIZE];
+    
+    // producers' side.
+    pthread_mutex_t tail_lock;
+    struct sakuc_sub_deque_ *tail_block;
+    size_t pushed;
+} sakuc_cdeque_t;
+
+/*  New a concurrent deque of blocks with @sub_deque_size elements of @elem_size bytes.
+    nullptr returned if failed.
+ */
+extern sakuc_cdeque_t *sakuc_cdeque_new(size_t sub_deque_size, size_t elem_size);
+
+/*  Producers. Push @data (with length @len which equals to @dq->elem_size) to the back,
+    wake up one blocked consumer if any. -1 returned if failed.
+ */
+extern int sakuc_cdeque_push_back(sakuc_cdeque_t *dq, const void *data, size_t len);
+
+/* Consumers' side. Push @data to the front. -1 returned if failed. */
+extern int sakuc_cdeque_push_front(sakuc_cdeque_t *dq, const void *data, size_t len);
+
+/* Consumers. popleft value to @data, -1 returned if failed or @dq is empty. */
+extern int sakuc_cdeque_pop_front(sakuc_cdeque_t *dq, void *data, size_t len);
+
+/*  Consumers. Same as #sakuc_cdeque_pop_front, but wait until an element is pushed,
+    at most @timeout_ms milliseconds (< 0 - forever, 0 - don't wait).
+    -1 returned if failed or timed out.
+ */
+extern int sakuc_cdeque_pop_front_timed(sakuc_cdeque_t *dq, void *data, size_t len,
+                                        long timeout_ms);
+
+/* approximate when used concurrently. */
+extern size_t sakuc_cdeque_length(sakuc_cdeque_t *dq);
+
+/* -1 returned if failed. No thread may use (or wait on) @dq any more. */
+extern int sakuc_cdeque_destroy(sakuc_cdeque_t *dq);
+
+#endif // SAKUC_CONCURRENT_DEQUE_H_
@@ -1,75 +1,613 @@
 // 2014-3-15 - created by jtuki@foxmail.com
 
+#define _GNU_SOURCE // pread, pwrite, posix_fadvise, O_TMPFILE, MAP_ANONYMOUS
+
+#include <sys/types.h>
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
 #include "deque.h"
 #include "common_memory_management_defs.h"
 
+/*  spill file of #sakuc_deque_new_spilling: slots of (@sub_deque_size * @elem_size)
+    bytes, a block in slot n is at offset n * slot_bytes.
+ */
+struct sakuc_deque_spill_ {
+    int fd;
+    size_t budget;          // bytes of the blocks in memory.
+    size_t resident_bytes;
+    size_t num_resident;    // blocks in memory.
+    size_t num_spilled;
+    size_t slot_bytes;
+    size_t num_slots;       // within the file, free or not.
+    size_t *free_slots;     // stack of the free ones.
+    size_t num_free_slots;
+    size_t free_slots_size;
+};
+
+static struct sakuc_sub_deque_ * sakuc_sub_dq_new_(struct sakuc_deque *dq, size_t size);
+static void sakuc_sub_dq_free_(struct sakuc_deque *dq, struct sakuc_sub_deque_ *sub_deque);
+static int sakuc_deque_init_(struct sakuc_deque *dq, size_t sub_deque_size,
+                             size_t max_sub_deque_size, size_t elem_size,
+                             int behavior, struct sakuc_deque_pool *pool,
+                             void *storage, size_t storage_size);
+static struct sakuc_sub_deque_ *sakuc_deque_spill_in_(struct sakuc_deque *dq, size_t index);
+static void sakuc_deque_read_ahead_(struct sakuc_deque *dq);
+
+#define sakuc_page_round_(bytes) (((bytes) + SAKUC_PAGE_SIZE - 1) / SAKUC_PAGE_SIZE * SAKUC_PAGE_SIZE)
+
+/*  one allocation of @bytes for the header and the elements of a block. Page-aligned
+    blocks are mapped directly on linux: malloc puts its chunk header in front of each
+    of them (posix_memalign as well as the over-allocation of osal_mem_aligned_alloc),
+    so that two of them could never share fewer than two pages. Elsewhere they fall
+    back to osal_mem_aligned_alloc. nullptr returned if failed.
+ */
+static struct sakuc_sub_deque_ *sakuc_sub_dq_alloc_(int behavior, size_t bytes)
+{
+    struct sakuc_sub_deque_ *sub = nullptr;
+#ifdef __linux__
+    if (behavior & SAKUC_DEQUE_PAGE_BLOCKS) {
+        void *p = mmap(nullptr, sakuc_page_round_(bytes), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return nullptr;
+        sub = (struct sakuc_sub_deque_ *) p;
+        sub->page_aligned = TRUE;
+        return sub;
+    }
+#endif
+    size_t align = (behavior & SAKUC_DEQUE_PAGE_BLOCKS) ? SAKUC_PAGE_SIZE : SAKUC_CACHE_LINE_SIZE;
+    sub = osal_mem_aligned_alloc(align, bytes);
+    if (!sub)
+        return nullptr;
+    sub->page_aligned = FALSE;
+    return sub;
+}
+
+/* free a block allocated by #sakuc_sub_dq_alloc_, of elements of @elem_size bytes. */
+static void sakuc_sub_dq_release_(struct sakuc_sub_deque_ *sub, size_t elem_size)
+{
+#ifdef __linux__
+    if (sub->page_aligned) {
+        munmap(sub, sakuc_page_round_(sakuc_sub_deque_bytes(sub->size, elem_size)));
+        return;
+    }
+#else
+    (void) elem_size;
+#endif
+    osal_mem_aligned_free(sub);
+}
+
 struct sakuc_deque *
 sakuc_deque_new(size_t sub_deque_size, size_t elem_size, int behavior)
 {
-    if (sub_deque_size == 0 || elem_size == 0)
+    return sakuc_deque_new_with_pool(sub_deque_size, elem_size, behavior, nullptr);
+}
+
+struct sakuc_deque *
+sakuc_deque_new_with_pool(size_t sub_deque_size, size_t elem_size, int behavior,
+                          struct sakuc_deque_pool *pool)
+{
+    sakuc_deque_t *dq = (sakuc_deque_t *) osal_mem_alloc(sizeof (sakuc_deque_t));
+    if (!dq)
+        return nullptr;
+    
+    if (sakuc_deque_init_(dq, sub_deque_size, sub_deque_size, elem_size, behavior, pool,
+                          nullptr, 0) == -1) {
+        osal_mem_free(dq);
+        return nullptr;
+    }
+    dq->owned = TRUE;
+    return dq;
+}
+
+struct sakuc_deque *
+sakuc_deque_new_growing(size_t sub_deque_size, size_t max_sub_deque_size, size_t elem_size,
+                        int behavior)
+{
+    if (max_sub_deque_size < sub_deque_size)
         return nullptr;
     
     sakuc_deque_t *dq = (sakuc_deque_t *) osal_mem_alloc(sizeof (sakuc_deque_t));
     if (!dq)
         return nullptr;
-
-    struct sakuc_sub_deque_ *sub_deque = osal_mem_alloc(sizeof (struct sakuc_sub_deque_));
-    if (!sub_deque) {
+    
+    if (sakuc_deque_init_(dq, sub_deque_size, max_sub_deque_size, elem_size, behavior, nullptr,
+                          nullptr, 0) == -1) {
         osal_mem_free(dq);
         return nullptr;
     }
+    dq->owned = TRUE;
+    return dq;
+}
 
-    void *buf = osal_mem_alloc(elem_size * sub_deque_size);
-    if (!buf) {
-        osal_mem_free(sub_deque);
-        osal_mem_free(dq);
+struct sakuc_deque *
+sakuc_deque_new_spilling(size_t sub_deque_size, size_t elem_size, int behavior,
+                         size_t memory_budget, const char *spill_dir)
+{
+#ifdef __linux__
+    sakuc_deque_t *dq = sakuc_deque_new(sub_deque_size, elem_size, behavior);
+    if (!dq)
+        return nullptr;
+    
+    struct sakuc_deque_spill_ *spill = osal_mem_calloc(1, sizeof (struct sakuc_deque_spill_));
+    if (!spill) {
+        sakuc_deque_destroy(dq);
         return nullptr;
     }
+    // unnamed, nothing is left behind whatever happens to the process.
+    spill->fd = open(spill_dir ? spill_dir : "/tmp", O_TMPFILE | O_RDWR, 0600);
+    if (spill->fd < 0) {
+        osal_mem_free(spill);
+        sakuc_deque_destroy(dq);
+        return nullptr;
+    }
+    spill->budget = memory_budget;
+    spill->slot_bytes = dq->sub_deque_size * elem_size;
+    spill->resident_bytes = sakuc_sub_deque_bytes(dq->sub_deque_size, elem_size);
+    spill->num_resident = 1;
+    dq->spill = spill;
+    return dq;
+#else
+    (void) sub_deque_size; (void) elem_size; (void) behavior;
+    (void) memory_budget; (void) spill_dir;
+    return nullptr;
+#endif
+}
 
-    sub_deque->length = sub_deque->start = sub_deque->end = 0;
-    sub_deque->data_buffer = buf;
-    sub_deque->next = sub_deque->prev = nullptr;
+int sakuc_deque_init(struct sakuc_deque *dq, size_t sub_deque_size, size_t elem_size,
+                     int behavior, void *storage, size_t storage_size)
+{
+    if (!dq)
+        return -1;
+    return sakuc_deque_init_(dq, sub_deque_size, sub_deque_size, elem_size, behavior, nullptr,
+                             storage, storage_size);
+}
 
+static int sakuc_deque_init_(struct sakuc_deque *dq, size_t sub_deque_size,
+                             size_t max_sub_deque_size, size_t elem_size,
+                             int behavior, struct sakuc_deque_pool *pool,
+                             void *storage, size_t storage_size)
+{
+    if (sub_deque_size == 0 || elem_size == 0)
+        return -1;
+    if (behavior & SAKUC_DEQUE_PAGE_BLOCKS) {
+        size_t bytes = sakuc_sub_deque_bytes(sub_deque_size, elem_size);
+        bytes = (bytes + SAKUC_PAGE_SIZE - 1) / SAKUC_PAGE_SIZE * SAKUC_PAGE_SIZE;
+        sub_deque_size = (bytes - sakuc_sub_deque_bytes(0, elem_size)) / elem_size;
+        if (max_sub_deque_size < sub_deque_size)
+            max_sub_deque_size = sub_deque_size;
+    }
+    if (pool && (pool->sub_deque_size != sub_deque_size || pool->elem_size != elem_size))
+        return -1;
+    
     dq->behavior = behavior;
     dq->sub_deque_size = sub_deque_size;
+    dq->max_sub_deque_size = max_sub_deque_size;
     dq->elem_size = elem_size;
-    dq->dq_head = dq->dq_tail = sub_deque;
+    dq->pool = pool;
+    dq->spare = nullptr;
+    dq->owned = FALSE;
+    dq->inline_block = nullptr;
+    dq->inline_block_used = FALSE;
+    dq->spill = nullptr;
+    
+    if (storage) {
+        // cache-line-aligned like the allocated blocks.
+        uintptr_t aligned = ((uintptr_t) storage + SAKUC_CACHE_LINE_SIZE - 1)
+                            & ~(uintptr_t) (SAKUC_CACHE_LINE_SIZE - 1);
+        if (aligned - (uintptr_t) storage + sakuc_sub_deque_bytes(sub_deque_size, elem_size)
+            > storage_size)
+            return -1;
+        dq->inline_block = (struct sakuc_sub_deque_ *) aligned;
+    }
+    
     dq->length = 0;
+    struct sakuc_sub_deque_ *sub_deque = sakuc_sub_dq_new_(dq, sub_deque_size);
+    if (!sub_deque)
+        return -1;
+    
+    dq->map = dq->map_inline;
+    dq->map_size = SAKUC_DEQUE_MAP_INLINE_SIZE;
+    dq->map_first = dq->map_head = SAKUC_DEQUE_MAP_INLINE_SIZE / 2;
+    dq->map[dq->map_first] = sub_deque;
+
+    dq->dq_head = dq->dq_tail = sub_deque;
     dq->num_sub_deque = 1;
 
-    return dq;
+    return 0;
 }
 
-/* new a sub deque if current sakuc_deque.dq_head and dq_tail cannot satisfy */
-static struct sakuc_sub_deque_ * sakuc_sub_dq_new_(size_t sub_deque_size, size_t elem_size)
+struct sakuc_deque_pool *
+sakuc_deque_pool_new(size_t sub_deque_size, size_t elem_size,
+                     size_t low_watermark, size_t high_watermark)
 {
-    void *buf = osal_mem_alloc(elem_size * sub_deque_size);
-    if (!buf) {
+    if (sub_deque_size == 0 || elem_size == 0 || low_watermark > high_watermark)
+        return nullptr;
+    
+    // calloc - clear malloc, statistics start at 0.
+    sakuc_deque_pool_t *pool = (sakuc_deque_pool_t *) osal_mem_calloc(1, sizeof (sakuc_deque_pool_t));
+    if (!pool)
         return nullptr;
+    
+    pool->sub_deque_size = sub_deque_size;
+    pool->elem_size = elem_size;
+    pool->low_watermark = low_watermark;
+    pool->high_watermark = high_watermark;
+    return pool;
+}
+
+int sakuc_deque_pool_destroy(struct sakuc_deque_pool *pool)
+{
+    if (!pool)
+        return -1;
+    
+    while (pool->free_list) {
+        struct sakuc_sub_deque_ *p = pool->free_list;
+        pool->free_list = p->next;
+        sakuc_sub_dq_release_(p, pool->elem_size);
+    }
+    osal_mem_free(pool);
+    return 0;
+}
+
+/*  make room for one more block map entry before @map_first (@at_front TRUE) or after
+    the last one. Recenter if the map is at most half used, otherwise double it.
+    -1 returned if failed to allocate memory.
+ */
+static int sakuc_deque_map_reserve_(struct sakuc_deque *dq, int at_front)
+{
+    if (at_front ? dq->map_first > 0 : dq->map_first + dq->num_sub_deque < dq->map_size)
+        return 0;
+    
+    struct sakuc_sub_deque_ **map = dq->map;
+    size_t map_size = dq->map_size;
+    if (2 * (dq->num_sub_deque + 1) > map_size) {
+        map_size *= 2;
+        map = osal_mem_alloc(map_size * sizeof(struct sakuc_sub_deque_ *));
+        if (!map)
+            return -1;
+    }
+    
+    size_t first = (map_size - dq->num_sub_deque) / 2;
+    memmove(map + first, dq->map + dq->map_first,
+            dq->num_sub_deque * sizeof(struct sakuc_sub_deque_ *));
+    if (map != dq->map) {
+        if (dq->map != dq->map_inline)
+            osal_mem_free(dq->map);
+        dq->map = map;
+        dq->map_size = map_size;
+    }
+    dq->map_head = dq->map_head - dq->map_first + first;
+    dq->map_first = first;
+    return 0;
+}
+
+/* index within @dq->map of @dq->dq_tail, there are few (swept) blocks after it. */
+static size_t sakuc_deque_tail_index_(struct sakuc_deque *dq)
+{
+    size_t i = dq->map_first + dq->num_sub_deque - 1;
+    while (dq->map[i] != dq->dq_tail)
+        -- i;
+    return i;
+}
+
+/* read or write (@to_file) all the @len bytes at @offset of the spill file. */
+static int sakuc_deque_spill_io_(int fd, char *buf, size_t len, off_t offset, int to_file)
+{
+#ifdef __linux__
+    while (len > 0) {
+        ssize_t n = to_file ? pwrite(fd, buf, len, offset) : pread(fd, buf, len, offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        buf += n;
+        len -= (size_t) n;
+        offset += n;
+    }
+    return 0;
+#else
+    (void) fd; (void) buf; (void) len; (void) offset; (void) to_file;
+    return -1;
+#endif
+}
+
+/* the elements of a block in slot @slot, from @start. */
+static off_t sakuc_deque_spill_offset_(struct sakuc_deque *dq, size_t slot, size_t start)
+{
+    return (off_t) (slot * dq->spill->slot_bytes + start * dq->elem_size);
+}
+
+/* the block within @slot is not spilled any more. */
+static void sakuc_deque_slot_free_(struct sakuc_deque_spill_ *spill, size_t slot)
+{
+    if (-- spill->num_spilled == 0) {
+        // all read back, give the disk space back too.
+#ifdef __linux__
+        if (ftruncate(spill->fd, 0) == 0) {
+            spill->num_slots = 0;
+            spill->num_free_slots = 0;
+            return;
+        }
+#endif
     }
+    
+    if (spill->num_free_slots == spill->free_slots_size) {
+        size_t size = spill->free_slots_size ? 2 * spill->free_slots_size : 64;
+        size_t *slots = osal_mem_alloc(size * sizeof(size_t));
+        if (!slots)
+            return; // lost until the file is truncated.
+        if (spill->free_slots) {
+            osal_memcpy(slots, spill->free_slots, spill->num_free_slots * sizeof(size_t));
+            osal_mem_free(spill->free_slots);
+        }
+        spill->free_slots = slots;
+        spill->free_slots_size = size;
+    }
+    spill->free_slots[spill->num_free_slots ++] = slot;
+}
 
-    // calloc - clear malloc.
-    struct sakuc_sub_deque_ *sub_deque = osal_mem_calloc(1, sizeof (struct sakuc_sub_deque_));
-    if (!sub_deque) {
-        osal_mem_free(buf);
+/* put @with in place of @old at @index: in the list, the map, and as head / tail. */
+static void sakuc_deque_replace_block_(struct sakuc_deque *dq, size_t index,
+                                       struct sakuc_sub_deque_ *old,
+                                       struct sakuc_sub_deque_ *with)
+{
+    if (old->prev)
+        old->prev->next = with;
+    if (old->next)
+        old->next->prev = with;
+    dq->map[index] = with;
+    if (dq->dq_head == old)
+        dq->dq_head = with;
+    if (dq->dq_tail == old)
+        dq->dq_tail = with;
+}
+
+/*  write the elements of the block at @index to the spill file, and replace it by a
+    header-only copy. -1 returned if failed, the block is untouched then.
+ */
+static int sakuc_deque_spill_out_(struct sakuc_deque *dq, size_t index)
+{
+    struct sakuc_deque_spill_ *spill = dq->spill;
+    struct sakuc_sub_deque_ *sub = dq->map[index];
+    struct sakuc_sub_deque_ *stub = osal_mem_alloc(sizeof (struct sakuc_sub_deque_));
+    if (!stub)
+        return -1;
+    
+    size_t slot = spill->num_free_slots > 0 ? spill->free_slots[spill->num_free_slots - 1]
+                                            : spill->num_slots;
+    if (sakuc_deque_spill_io_(spill->fd, sub->data_buffer + sub->start * dq->elem_size,
+                              (sub->end - sub->start) * dq->elem_size,
+                              sakuc_deque_spill_offset_(dq, slot, sub->start), TRUE) == -1) {
+        osal_mem_free(stub);
+        return -1;
+    }
+    if (spill->num_free_slots > 0)
+        -- spill->num_free_slots;
+    else
+        ++ spill->num_slots;
+    
+    osal_memcpy(stub, sub, sizeof (struct sakuc_sub_deque_));
+    stub->spill_slot = slot;
+    sakuc_deque_replace_block_(dq, index, sub, stub);
+    spill->resident_bytes -= sakuc_sub_deque_bytes(sub->size, dq->elem_size);
+    -- spill->num_resident;
+    ++ spill->num_spilled;
+    sakuc_sub_dq_release_(sub, dq->elem_size);
+    return 0;
+}
+
+/*  spill blocks until a new one of @bytes fits within the budget, the coldest first:
+    the nearest to the tail. The tail, the head and its read-ahead stay in memory.
+ */
+static void sakuc_deque_make_room_(struct sakuc_deque *dq, size_t bytes)
+{
+    struct sakuc_deque_spill_ *spill = dq->spill;
+    if (spill->resident_bytes + bytes <= spill->budget)
+        return;
+    
+    sakuc_deque_sweep(dq, SAKUC_DEQUE_SWEEP_MANUALLY);
+    size_t window_end = dq->map_head + SAKUC_DEQUE_SPILL_READ_AHEAD;
+    // once swept, blocks in memory other than the head, its read-ahead and the tail are
+    // in between, no need to look for them otherwise.
+    while (spill->resident_bytes + bytes > spill->budget
+           && spill->num_resident > SAKUC_DEQUE_SPILL_READ_AHEAD + 2) {
+        size_t victim = sakuc_deque_tail_index_(dq);
+        if (victim <= window_end + 1)
+            break;
+        do {
+            -- victim;
+        } while (victim > window_end && dq->map[victim]->spill_slot != SAKUC_SUB_DEQUE_RESIDENT);
+        if (victim <= window_end || sakuc_deque_spill_out_(dq, victim) == -1)
+            break;
+    }
+}
+
+/*  read the spilled block at @index back (the tail side spilled to make room if needed).
+    nullptr returned if failed, it stays spilled then.
+ */
+static struct sakuc_sub_deque_ *sakuc_deque_spill_in_(struct sakuc_deque *dq, size_t index)
+{
+    struct sakuc_deque_spill_ *spill = dq->spill;
+    size_t bytes = sakuc_sub_deque_bytes(dq->map[index]->size, dq->elem_size);
+    sakuc_deque_make_room_(dq, bytes);
+    
+    struct sakuc_sub_deque_ *stub = dq->map[index];
+    struct sakuc_sub_deque_ *sub = sakuc_sub_dq_alloc_(dq->behavior, bytes);
+    if (!sub)
         return nullptr;
+    if (sakuc_deque_spill_io_(spill->fd, sub->data_buffer + stub->start * dq->elem_size,
+                              (stub->end - stub->start) * dq->elem_size,
+                              sakuc_deque_spill_offset_(dq, stub->spill_slot, stub->start),
+                              FALSE) == -1) {
+        sub->size = stub->size;
+        sakuc_sub_dq_release_(sub, dq->elem_size);
+        return nullptr;
+    }
+    
+    int page_aligned = sub->page_aligned;
+    osal_memcpy(sub, stub, sizeof (struct sakuc_sub_deque_));
+    sub->page_aligned = page_aligned;
+    sub->spill_slot = SAKUC_SUB_DEQUE_RESIDENT;
+    sakuc_deque_replace_block_(dq, index, stub, sub);
+    sakuc_deque_slot_free_(spill, stub->spill_slot);
+    osal_mem_free(stub);
+    spill->resident_bytes += bytes;
+    ++ spill->num_resident;
+    return sub;
+}
+
+/*  the head moved to the next block: read the next SAKUC_DEQUE_SPILL_READ_AHEAD
+    blocks back, and let the kernel read ahead as many after them.
+ */
+static void sakuc_deque_read_ahead_(struct sakuc_deque *dq)
+{
+    size_t tail = sakuc_deque_tail_index_(dq);
+    for (size_t k = 1; k <= 2 * SAKUC_DEQUE_SPILL_READ_AHEAD && dq->map_head + k < tail; k++) {
+        struct sakuc_sub_deque_ *sub = dq->map[dq->map_head + k];
+        if (sub->spill_slot == SAKUC_SUB_DEQUE_RESIDENT)
+            continue;
+        if (k <= SAKUC_DEQUE_SPILL_READ_AHEAD)
+            sakuc_deque_spill_in_(dq, dq->map_head + k); // if failed, again once the head is there.
+#ifdef __linux__
+        else
+            posix_fadvise(dq->spill->fd, sakuc_deque_spill_offset_(dq, sub->spill_slot, sub->start),
+                          (off_t) ((sub->end - sub->start) * dq->elem_size), POSIX_FADV_WILLNEED);
+#endif
     }
+}
 
-    sub_deque->data_buffer = buf;
+/*  the size of the next block: @sub_deque_size, or about half the deque's length if
+    the blocks grow (doubling from @sub_deque_size, up to @max_sub_deque_size).
+ */
+static size_t sakuc_deque_block_size_(struct sakuc_deque *dq)
+{
+    size_t size = dq->sub_deque_size;
+    while (size < dq->max_sub_deque_size && 2 * size <= dq->length)
+        size *= 2;
+    return size < dq->max_sub_deque_size ? size : dq->max_sub_deque_size;
+}
+
+/*  new a sub deque of @size elements if current sakuc_deque.dq_head and dq_tail cannot
+    satisfy, taken from @dq->pool if any (blocks of its size only). The header is
+    cleared, not the elements. The inline block is taken first for @sub_deque_size.
+ */
+static struct sakuc_sub_deque_ * sakuc_sub_dq_new_(struct sakuc_deque *dq, size_t size)
+{
+    struct sakuc_deque_pool *pool = dq->pool;
+    struct sakuc_sub_deque_ *sub_deque = nullptr;
+    int page_aligned = FALSE;
+    
+    if (pool && size != pool->sub_deque_size)
+        pool = nullptr;
+    
+    if (dq->inline_block && !dq->inline_block_used && size == dq->sub_deque_size) {
+        sub_deque = dq->inline_block;
+        dq->inline_block_used = TRUE;
+    }
+    else if (pool && pool->free_list) {
+        sub_deque = pool->free_list;
+        pool->free_list = sub_deque->next;
+        page_aligned = sub_deque->page_aligned;
+        -- pool->num_free;
+        ++ pool->hits;
+    }
+    else if (dq->spare && size == dq->spare->size) {
+        sub_deque = dq->spare;
+        dq->spare = nullptr;
+        page_aligned = TRUE;
+    }
+    else {
+        size_t bytes = sakuc_sub_deque_bytes(size, dq->elem_size);
+        if (dq->spill)
+            sakuc_deque_make_room_(dq, bytes);
+        sub_deque = sakuc_sub_dq_alloc_(dq->behavior, bytes);
+        if (!sub_deque)
+            return nullptr;
+        page_aligned = sub_deque->page_aligned;
+        if (pool)
+            ++ pool->misses;
+        if (dq->spill) {
+            dq->spill->resident_bytes += bytes;
+            ++ dq->spill->num_resident;
+        }
+    }
+    
+    osal_memset(sub_deque, 0, sizeof (struct sakuc_sub_deque_));
+    sub_deque->page_aligned = page_aligned;
+    sub_deque->size = size;
+    sub_deque->spill_slot = SAKUC_SUB_DEQUE_RESIDENT;
     return sub_deque;
 }
 
-int sakuc_deque_push_back(struct sakuc_deque *dq, const void *data, size_t len)
+/*  give @sub_deque back to @dq->pool if any, otherwise free it.
+    Past the pool's high watermark, trim it down to the low watermark.
+ */
+static void sakuc_sub_dq_free_(struct sakuc_deque *dq, struct sakuc_sub_deque_ *sub_deque)
+{
+    if (sub_deque == dq->inline_block) {
+        dq->inline_block_used = FALSE;
+        return;
+    }
+    if (dq->spill) {
+        if (sub_deque->spill_slot != SAKUC_SUB_DEQUE_RESIDENT) {
+            sakuc_deque_slot_free_(dq->spill, sub_deque->spill_slot);
+            osal_mem_free(sub_deque);
+            return;
+        }
+        dq->spill->resident_bytes -= sakuc_sub_deque_bytes(sub_deque->size, dq->elem_size);
+        -- dq->spill->num_resident;
+    }
+    
+    struct sakuc_deque_pool *pool = dq->pool;
+    if (!pool || sub_deque->size != pool->sub_deque_size) {
+        // a spilling deque's budget doesn't count the spare.
+        if (sub_deque->page_aligned && !dq->spill) {
+            if (dq->spare)
+                sakuc_sub_dq_release_(dq->spare, dq->elem_size);
+            dq->spare = sub_deque;
+        }
+        else {
+            sakuc_sub_dq_release_(sub_deque, dq->elem_size);
+        }
+        return;
+    }
+    
+    sub_deque->next = pool->free_list;
+    sub_deque->prev = nullptr;
+    pool->free_list = sub_deque;
+    ++ pool->num_free;
+    
+    if (pool->num_free > pool->high_watermark) {
+        while (pool->num_free > pool->low_watermark) {
+            struct sakuc_sub_deque_ *p = pool->free_list;
+            pool->free_list = p->next;
+            sakuc_sub_dq_release_(p, pool->elem_size);
+            -- pool->num_free;
+            ++ pool->released;
+        }
+    }
+}
+
+/* the tail block with room for #push_back, nullptr if failed. */
+static struct sakuc_sub_deque_ *sakuc_deque_back_block_(struct sakuc_deque *dq)
 {
     struct sakuc_sub_deque_ *tail = nullptr;
 
     // find the tail, if current tail is full, create a new sub_deque node as tail.
-    if (dq->dq_tail->end < dq->sub_deque_size) {
+    if (dq->dq_tail->end < dq->dq_tail->size) {
         tail = dq->dq_tail;
     }
     else if (dq->dq_tail->next == nullptr) {
-        struct sakuc_sub_deque_ *sub_dq = sakuc_sub_dq_new_(dq->sub_deque_size, dq->elem_size);
+        struct sakuc_sub_deque_ *sub_dq = nullptr;
+        if (sakuc_deque_map_reserve_(dq, FALSE) == 0)
+            sub_dq = sakuc_sub_dq_new_(dq, sakuc_deque_block_size_(dq));
         if (sub_dq) {
+            dq->map[dq->map_first + dq->num_sub_deque] = sub_dq;
             sub_dq->prev = dq->dq_tail;
             dq->dq_tail->next = sub_dq;
             dq->dq_tail = sub_dq;
@@ -81,7 +619,7 @@ int sakuc_deque_push_back(struct sakuc_deque *dq, const void *data, size_t len)
     else {
         // if not empty and valid sub_deque, some problem has occured, simply keep @tail as nullptr.
         struct sakuc_sub_deque_ *p = dq->dq_tail->next;
-        if (p->length == 0 && p->start == 0 && p->end == 0 && p->data_buffer) {
+        if (p->length == 0 && p->start == 0 && p->end == 0) {
             p->prev = dq->dq_tail;
             dq->dq_tail = p;
         
@@ -89,6 +627,13 @@ int sakuc_deque_push_back(struct sakuc_deque *dq, const void *data, size_t len)
         }
     }
     
+    return tail;
+}
+
+int sakuc_deque_push_back(struct sakuc_deque *dq, const void *data, size_t len)
+{
+    struct sakuc_sub_deque_ *tail = sakuc_deque_back_block_(dq);
+    
     if (tail) {
         osal_memcpy((char *)tail->data_buffer + tail->end * dq->elem_size, data, len);
         ++ tail->end;
@@ -109,11 +654,17 @@ int sakuc_deque_push_front(struct sakuc_deque *dq, const void *data, size_t len)
         head = dq->dq_head;
     }
     else if (dq->dq_head->prev == nullptr) {
-        struct sakuc_sub_deque_ *sub_dq = sakuc_sub_dq_new_(dq->sub_deque_size, dq->elem_size);
+        struct sakuc_sub_deque_ *sub_dq = nullptr;
+        if (sakuc_deque_map_reserve_(dq, TRUE) == 0)
+            sub_dq = sakuc_sub_dq_new_(dq, sakuc_deque_block_size_(dq));
         if (sub_dq) {
+            // @dq_head is the first block, @map_head == @map_first.
+            dq->map[-- dq->map_first] = sub_dq;
+            dq->map_head = dq->map_first;
+            
             // refer to @start and @end - two invariant member.
             sub_dq->length = 0;
-            sub_dq->start = sub_dq->end = dq->sub_deque_size;
+            sub_dq->start = sub_dq->end = sub_dq->size;
         
             sub_dq->next = dq->dq_head;
             dq->dq_head->prev = sub_dq;
@@ -126,11 +677,12 @@ int sakuc_deque_push_front(struct sakuc_deque *dq, const void *data, size_t len)
     else {
         // if not empty and valid sub_deque, some problem has occured, simply keep @tail as nullptr.
         struct sakuc_sub_deque_ *p = dq->dq_head->prev;
-        if (p->length == 0 && p->data_buffer 
-            && p->end == dq->sub_deque_size && p->start == dq->sub_deque_size)
+        if (p->length == 0
+            && p->end == p->size && p->start == p->size)
         {
             dq->dq_head->prev->next = dq->dq_head;
             dq->dq_head = dq->dq_head->prev;
+            -- dq->map_head;
         
             head = p;
         }
@@ -158,7 +710,14 @@ int sakuc_deque_pop_back(struct sakuc_deque *dq, void *data, size_t len)
              && dq->dq_tail->prev)
     {
         struct sakuc_sub_deque_ *p = dq->dq_tail->prev;
-        if (p->length > 0 && p->end == dq->sub_deque_size) {
+        if (p->length > 0 && p->end == p->size) {
+            if (p->spill_slot != SAKUC_SUB_DEQUE_RESIDENT)
+                p = sakuc_deque_spill_in_(dq, sakuc_deque_tail_index_(dq) - 1);
+        }
+        else
+            p = nullptr;
+        
+        if (p) {
             dq->dq_tail = p;
             tail = p;
             
@@ -178,25 +737,39 @@ int sakuc_deque_pop_back(struct sakuc_deque *dq, void *data, size_t len)
         return -1;
 }
 
-int sakuc_deque_pop_front(struct sakuc_deque *dq, void *data, size_t len)
+/* the head block holding the front element, nullptr if @dq is empty. */
+static struct sakuc_sub_deque_ *sakuc_deque_front_block_(struct sakuc_deque *dq)
 {
     struct sakuc_sub_deque_ *head = nullptr;
     
     if (dq->dq_head->start < dq->dq_head->end) // not empty
         head = dq->dq_head;
-    else if (dq->dq_head->start == dq->sub_deque_size && dq->dq_head->end == dq->sub_deque_size
+    else if (dq->dq_head->start == dq->dq_head->size && dq->dq_head->end == dq->dq_head->size
              && dq->dq_head->next)
     {
         struct sakuc_sub_deque_ *p = dq->dq_head->next;
         if (p->length > 0 && p->start == 0) {
+            if (p->spill_slot != SAKUC_SUB_DEQUE_RESIDENT
+                && !(p = sakuc_deque_spill_in_(dq, dq->map_head + 1)))
+                return nullptr;
             dq->dq_head = p;
+            ++ dq->map_head;
             head = p;
             
             if (dq->behavior & SAKUC_DEQUE_SWEEP_IMMEDIATELY)
                 sakuc_deque_sweep(dq, SAKUC_DEQUE_SWEEP_HEAD);
+            if (dq->spill)
+                sakuc_deque_read_ahead_(dq);
         }
     }
     
+    return head;
+}
+
+int sakuc_deque_pop_front(struct sakuc_deque *dq, void *data, size_t len)
+{
+    struct sakuc_sub_deque_ *head = sakuc_deque_front_block_(dq);
+    
     if (head) {
         osal_memcpy(data, (char *)head->data_buffer + head->start * dq->elem_size, len);
         ++ head->start;
@@ -228,25 +801,22 @@ int sakuc_deque_sweep(struct sakuc_deque *dq, int behavior)
         while (sweep != nullptr) {
             next_sweep = sweep->prev;
             
-            if (sweep->data_buffer)
-                osal_mem_free(sweep->data_buffer);
-            osal_mem_free(sweep);
+            sakuc_sub_dq_free_(dq, sweep);
             -- dq->num_sub_deque;
             
             sweep = next_sweep;
         }
+        dq->map_first = dq->map_head;
     }
     
-    // sweep the tail's next list.
+    // sweep the tail's next list (the end of the map, nothing to update there).
     if (behavior & SAKUC_DEQUE_SWEEP_TAIL) {
         sweep = dq->dq_tail->next;
         dq->dq_tail->next = nullptr;
         
         while (sweep != nullptr) {
             next_sweep = sweep->next;
-            if (sweep->data_buffer)
-                osal_mem_free(sweep->data_buffer);
-            osal_mem_free(sweep);
+            sakuc_sub_dq_free_(dq, sweep);
             -- dq->num_sub_deque;
             
             sweep = next_sweep;
@@ -256,6 +826,266 @@ int sakuc_deque_sweep(struct sakuc_deque *dq, int behavior)
     return 0;
 }
 
+size_t sakuc_deque_push_back_n(struct sakuc_deque *dq, const void *data, size_t n, size_t len)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return 0;
+    
+    size_t pushed = 0;
+    while (pushed < n) {
+        struct sakuc_sub_deque_ *tail = sakuc_deque_back_block_(dq);
+        if (!tail)
+            break;
+        
+        size_t m = tail->size - tail->end;
+        if (m > n - pushed)
+            m = n - pushed;
+        osal_memcpy((char *)tail->data_buffer + tail->end * len,
+                    (const char *)data + pushed * len, m * len);
+        tail->end += m;
+        tail->length += m;
+        dq->length += m;
+        pushed += m;
+    }
+    return pushed;
+}
+
+size_t sakuc_deque_pop_front_n(struct sakuc_deque *dq, void *data, size_t n, size_t len)
+{
+    if (!dq || !data || len != dq->elem_size)
+        return 0;
+    
+    size_t popped = 0;
+    while (popped < n) {
+        struct sakuc_sub_deque_ *head = sakuc_deque_front_block_(dq);
+        if (!head)
+            break;
+        
+        size_t m = head->end - head->start;
+        if (m > n - popped)
+            m = n - popped;
+        osal_memcpy((char *)data + popped * len,
+                    (char *)head->data_buffer + head->start * len, m * len);
+        head->start += m;
+        head->length -= m;
+        dq->length -= m;
+        popped += m;
+    }
+    return popped;
+}
+
+void sakuc_deque_iter_init(struct sakuc_deque *dq, struct sakuc_deque_iter *iter)
+{
+    iter->dq = dq;
+    iter->block = dq->map_head;
+    iter->pos = dq->dq_head->start;
+    iter->remaining = dq->length;
+}
+
+size_t sakuc_deque_iter_next(struct sakuc_deque_iter *iter, void **elems)
+{
+    struct sakuc_deque *dq = iter->dq;
+    
+    // the head block might be empty (popped to its end) while the next one is not.
+    while (iter->remaining > 0) {
+        struct sakuc_sub_deque_ *sub = dq->map[iter->block];
+        if (sub->spill_slot != SAKUC_SUB_DEQUE_RESIDENT
+            && !(sub = sakuc_deque_spill_in_(dq, iter->block)))
+            return 0;
+        size_t count = sub->end - iter->pos;
+        if (count > iter->remaining)
+            count = iter->remaining;
+        
+        size_t pos = iter->pos;
+        ++ iter->block;
+        iter->pos = 0;
+        if (count > 0) {
+            *elems = (char *)sub->data_buffer + pos * dq->elem_size;
+            iter->remaining -= count;
+            return count;
+        }
+    }
+    return 0;
+}
+
+void *sakuc_deque_at(struct sakuc_deque *dq, size_t i)
+{
+    if (!dq || i >= dq->length)
+        return nullptr;
+    
+    if (dq->max_sub_deque_size == dq->sub_deque_size) {
+        // every block between @dq_head and @dq_tail is full, the head one up to its end.
+        size_t pos = dq->dq_head->start + i;
+        size_t index = dq->map_head + pos / dq->sub_deque_size;
+        struct sakuc_sub_deque_ *sub = dq->map[index];
+        if (sub->spill_slot != SAKUC_SUB_DEQUE_RESIDENT && !(sub = sakuc_deque_spill_in_(dq, index)))
+            return nullptr;
+        return (char *)sub->data_buffer + (pos % dq->sub_deque_size) * dq->elem_size;
+    }
+    
+    // blocks of different sizes, walk them from the nearer end.
+    struct sakuc_sub_deque_ *sub;
+    if (i < dq->length / 2) {
+        sub = dq->dq_head;
+        while (i >= sub->length) {
+            i -= sub->length;
+            sub = sub->next;
+        }
+        return (char *)sub->data_buffer + (sub->start + i) * dq->elem_size;
+    }
+    else {
+        size_t j = dq->length - 1 - i;  // from the back.
+        sub = dq->dq_tail;
+        while (j >= sub->length) {
+            j -= sub->length;
+            sub = sub->prev;
+        }
+        return (char *)sub->data_buffer + (sub->end - 1 - j) * dq->elem_size;
+    }
+}
+
+/* the size of a block to hold @left elements, within the size limits. */
+static size_t sakuc_deque_fit_size_(struct sakuc_deque *dq, size_t left)
+{
+    if (left < dq->sub_deque_size)
+        return dq->sub_deque_size;
+    return left < dq->max_sub_deque_size ? left : dq->max_sub_deque_size;
+}
+
+/*  move the elements into new blocks sized by #sakuc_deque_fit_size_, and free the
+    old ones. -1 returned if failed to allocate memory, @dq is untouched then.
+ */
+static int sakuc_deque_repack_(struct sakuc_deque *dq)
+{
+    struct sakuc_sub_deque_ *head = nullptr, *tail = nullptr;
+    size_t num_blocks = 0, left = dq->length;
+    do {
+        size_t size = sakuc_deque_fit_size_(dq, left);
+        left -= size < left ? size : left;
+        struct sakuc_sub_deque_ *sub = sakuc_sub_dq_new_(dq, size);
+        if (!sub) {
+            while (head) {
+                struct sakuc_sub_deque_ *next = head->next;
+                sakuc_sub_dq_free_(dq, head);
+                head = next;
+            }
+            return -1;
+        }
+        sub->prev = tail;
+        if (tail)
+            tail->next = sub;
+        else
+            head = sub;
+        tail = sub;
+        ++ num_blocks;
+    } while (left > 0);
+    
+    // copy the elements block by block.
+    struct sakuc_deque_iter it;
+    struct sakuc_sub_deque_ *to = head;
+    void *elems;
+    size_t count;
+    sakuc_deque_iter_init(dq, &it);
+    while ((count = sakuc_deque_iter_next(&it, &elems)) > 0) {
+        while (count > 0) {
+            if (to->end == to->size)
+                to = to->next;
+            size_t m = to->size - to->end;
+            if (m > count)
+                m = count;
+            osal_memcpy((char *)to->data_buffer + to->end * dq->elem_size, elems,
+                        m * dq->elem_size);
+            to->end += m;
+            to->length += m;
+            elems = (char *)elems + m * dq->elem_size;
+            count -= m;
+        }
+    }
+    
+    for (struct sakuc_sub_deque_ *p = dq->dq_head, *next; p; p = next) {
+        next = p->next;
+        sakuc_sub_dq_free_(dq, p);
+    }
+    // the map is large enough, there are fewer blocks than before.
+    size_t i = dq->map_first;
+    for (struct sakuc_sub_deque_ *p = head; p; p = p->next)
+        dq->map[i++] = p;
+    dq->map_head = dq->map_first;
+    dq->dq_head = head;
+    dq->dq_tail = tail;
+    dq->num_sub_deque = num_blocks;
+    return 0;
+}
+
+int sakuc_deque_shrink_to_fit(struct sakuc_deque *dq)
+{
+    if (!dq || !dq->dq_head || !dq->dq_tail)
+        return -1;
+    
+    sakuc_deque_sweep(dq, SAKUC_DEQUE_SWEEP_MANUALLY);
+    
+    // repack only if it saves memory.
+    size_t capacity = 0, fit_capacity = 0, left = dq->length;
+    for (struct sakuc_sub_deque_ *p = dq->dq_head; p; p = p->next)
+        capacity += p->size;
+    do {
+        size_t size = sakuc_deque_fit_size_(dq, left);
+        left -= size < left ? size : left;
+        fit_capacity += size;
+    } while (left > 0);
+    // spilled blocks stay where they are.
+    if (!dq->spill && fit_capacity < capacity && sakuc_deque_repack_(dq) == -1)
+        return -1;
+    if (dq->spare) {
+        sakuc_sub_dq_release_(dq->spare, dq->elem_size);
+        dq->spare = nullptr;
+    }
+    
+    if (dq->map != dq->map_inline && dq->num_sub_deque <= SAKUC_DEQUE_MAP_INLINE_SIZE / 2) {
+        size_t first = (SAKUC_DEQUE_MAP_INLINE_SIZE - dq->num_sub_deque) / 2;
+        osal_memcpy(dq->map_inline + first, dq->map + dq->map_first,
+                    dq->num_sub_deque * sizeof(struct sakuc_sub_deque_ *));
+        osal_mem_free(dq->map);
+        dq->map = dq->map_inline;
+        dq->map_size = SAKUC_DEQUE_MAP_INLINE_SIZE;
+        dq->map_head = dq->map_head - dq->map_first + first;
+        dq->map_first = first;
+    }
+    return 0;
+}
+
+size_t sakuc_deque_memory(struct sakuc_deque *dq, struct sakuc_deque_memory *mem)
+{
+    struct sakuc_deque_memory m = {0};
+    if (!dq)
+        return 0;
+    
+    struct sakuc_sub_deque_ *p = dq->dq_head;
+    while (p->prev)
+        p = p->prev;
+    for (; p; p = p->next) {
+        ++ m.num_blocks;
+        m.capacity += p->size;
+        if (p->spill_slot != SAKUC_SUB_DEQUE_RESIDENT) {
+            ++ m.num_spilled;
+            m.spilled_bytes += (p->end - p->start) * dq->elem_size;
+            m.block_bytes += sizeof (struct sakuc_sub_deque_);
+        }
+        else if (p != dq->inline_block)
+            m.block_bytes += sakuc_sub_deque_bytes(p->size, dq->elem_size);
+    }
+    if (dq->spare)
+        m.block_bytes += sakuc_sub_deque_bytes(dq->spare->size, dq->elem_size);
+    m.used_bytes = dq->length * dq->elem_size;
+    if (dq->map != dq->map_inline)
+        m.map_bytes = dq->map_size * sizeof(struct sakuc_sub_deque_ *);
+    m.total_bytes = m.block_bytes + m.map_bytes + (dq->owned ? sizeof(struct sakuc_deque) : 0);
+    
+    if (mem)
+        *mem = m;
+    return m.total_bytes;
+}
+
 int sakuc_deque_destroy(struct sakuc_deque *dq)
 {
     if (!dq || !dq->dq_head || !dq->dq_tail)
@@ -268,15 +1098,24 @@ int sakuc_deque_destroy(struct sakuc_deque *dq)
     struct sakuc_sub_deque_ *next_destroy = nullptr;
     do {
         next_destroy = p->next;
-
-        // best-effort memory free process.
-        if (p->data_buffer)
-            osal_mem_free(p->data_buffer);
-        osal_mem_free(p);
+        sakuc_sub_dq_free_(dq, p);
         
         p = next_destroy;
     } while (p != nullptr);
+    if (dq->spare)
+        sakuc_sub_dq_release_(dq->spare, dq->elem_size);
     
-    osal_mem_free(dq);    
+    if (dq->map != dq->map_inline)
+        osal_mem_free(dq->map);
+    if (dq->spill) {
+#ifdef __linux__
+        close(dq->spill->fd);
+#endif
+        if (dq->spill->free_slots)
+            osal_mem_free(dq->spill->free_slots);
+        osal_mem_free(dq->spill);
+    }
+    if (dq->owned)
+        osal_mem_free(dq);
     return 0;
 }
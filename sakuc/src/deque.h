@@ -10,6 +10,11 @@ struct sakuc_sub_deque_
     struct sakuc_sub_deque_ *next;
     struct sakuc_sub_deque_ *prev;
     size_t length;  // current length of queue
+    size_t size;    // capacity in elements, sakuc_deque.sub_deque_size unless the blocks grow.
+    size_t spill_slot;  // SAKUC_SUB_DEQUE_RESIDENT, or the slot of the spill file holding
+                        // the elements: this is a header-only copy of the block then.
+    int page_aligned;   // mapped pages of its own (SAKUC_DEQUE_PAGE_BLOCKS on linux),
+                        // not from osal_mem_aligned_alloc.
     
     // below are two invariants.
     size_t start;   // _always_ the next place to be #pop_front if (start < end).
@@ -17,15 +22,57 @@ struct sakuc_sub_deque_
     size_t end;     // _always_ the next place to be #push_back if (end < sakuc_deque_t.sub_deque_size).
                     // as to #pop_back, decrement end first if end > 0, then pop the value there.
     
-    // with length of (sakuc_deque.sub_deque_size * sakuc_deque.elem_size)
-    void *data_buffer;
+    // with length of (@size * sakuc_deque.elem_size), inline:
+    // the header and the elements are one cache-line-aligned (or page-aligned) allocation.
+    char data_buffer[];
 };
 
+#define SAKUC_SUB_DEQUE_RESIDENT ((size_t) -1)
+
+// bytes of one sub deque (header included) of @sub_deque_size elements.
+#define sakuc_sub_deque_bytes(sub_deque_size, elem_size) \
+    (offsetof(struct sakuc_sub_deque_, data_buffer) + (sub_deque_size) * (elem_size))
+
+/*  Free-list of sub deques, shared by any number of deques of the same geometry
+    (single thread). Swept blocks are kept there and reused by the next push
+    without malloc. Once more than @high_watermark blocks are free, the list is
+    trimmed down to @low_watermark, so that an oscillating queue neither thrashes
+    the allocator nor keeps a peak's worth of memory forever.
+ */
+typedef struct sakuc_deque_pool
+{
+    struct sakuc_sub_deque_ *free_list; // linked by @next.
+    size_t num_free;
+    
+    size_t sub_deque_size;
+    size_t elem_size;
+    size_t low_watermark;
+    size_t high_watermark;
+    
+    // statistics.
+    size_t hits;        // blocks taken from the pool.
+    size_t misses;      // blocks allocated because the pool was empty.
+    size_t released;    // blocks given back to the allocator by trimming.
+} sakuc_deque_pool_t;
+
 // behavior bit-vector, 0x0001 0x0080 etc.
 #define SAKUC_DEQUE_SWEEP_IMMEDIATELY   0x0001
 #define SAKUC_DEQUE_SWEEP_MANUALLY      0x0002
 #define SAKUC_DEQUE_SWEEP_HEAD          0x0004
 #define SAKUC_DEQUE_SWEEP_TAIL          0x0008
+// round @sub_deque_size up so that every block fills whole pages (SAKUC_PAGE_SIZE),
+// page-aligned, refer to #sakuc_deque_new.
+#define SAKUC_DEQUE_PAGE_BLOCKS         0x0010
+
+// blocks after the head one kept in memory by a spilling deque, refer to #sakuc_deque_new_spilling.
+#define SAKUC_DEQUE_SPILL_READ_AHEAD 2
+
+// block map entries within sakuc_deque_t itself, before the map has to grow.
+#define SAKUC_DEQUE_MAP_INLINE_SIZE 8
+
+// bytes of the caller-provided storage holding the first block, refer to #sakuc_deque_init.
+#define SAKUC_DEQUE_INLINE_STORAGE_SIZE(sub_deque_size, elem_size) \
+    (sakuc_sub_deque_bytes((sub_deque_size), (elem_size)) + SAKUC_CACHE_LINE_SIZE - 1)
 
 typedef struct sakuc_deque
 {
@@ -34,10 +81,36 @@ typedef struct sakuc_deque
 
     int behavior;           // OR-ed behavior bit-vector.
     size_t sub_deque_size;  // how many elements are there within each sub-queue.
+    size_t max_sub_deque_size;  // blocks grow up to it, == @sub_deque_size - fixed size.
     size_t elem_size;       // sizeof each element.
 
     size_t length;
     size_t num_sub_deque;
+    
+    // block map (like std::deque's): every sub deque of the list above, in the same
+    // order, is @map[map_first] ~ @map[map_first + num_sub_deque - 1], so that the
+    // i-th element is found without walking the list, refer to #sakuc_deque_at.
+    // Room is kept on both sides of the used range, it grows in amortized O(1).
+    struct sakuc_sub_deque_ **map;  // @map_inline until it grows.
+    size_t map_size;
+    size_t map_first;
+    size_t map_head;        // @map[map_head] == @dq_head.
+    struct sakuc_sub_deque_ *map_inline[SAKUC_DEQUE_MAP_INLINE_SIZE];
+    
+    // nullptr - blocks are allocated and freed directly.
+    struct sakuc_deque_pool *pool;
+    // the last freed page block not taken by @pool (SAKUC_DEQUE_PAGE_BLOCKS), for the
+    // next new one, so that a steady queue does not map and unmap pages all the time.
+    struct sakuc_sub_deque_ *spare;
+    
+    // the block living in the storage given to #sakuc_deque_init (nullptr - none),
+    // used first whenever a block is needed and it is free; never freed nor pooled.
+    struct sakuc_sub_deque_ *inline_block;
+    int inline_block_used;
+    int owned;              // allocated by #sakuc_deque_new, freed by #sakuc_deque_destroy.
+    
+    // nullptr - every block is in memory, refer to #sakuc_deque_new_spilling.
+    struct sakuc_deque_spill_ *spill;
 } sakuc_deque_t;
 
 /*
@@ -46,10 +119,83 @@ typedef struct sakuc_deque
         SAKUC_DEQUE_SWEEP_MANUALLY   
         SAKUC_DEQUE_SWEEP_HEAD       
         SAKUC_DEQUE_SWEEP_TAIL        
+        SAKUC_DEQUE_PAGE_BLOCKS - @sub_deque_size becomes the largest count which
+            fits in the same number of pages as the requested one, and blocks are
+            mapped directly (pages of their own, no malloc overhead, linux only;
+            page-aligned malloc elsewhere), so that they are friendly to the
+            allocator and transparent huge pages.
  */
 extern struct sakuc_deque *
 sakuc_deque_new(size_t sub_deque_size, size_t elem_size, int behavior);
 
+/*  Same as #sakuc_deque_new, but blocks come from and go back to @pool (nullptr -
+    no pool), which must have the same geometry (after SAKUC_DEQUE_PAGE_BLOCKS
+    rounding) and outlive the deque.
+ */
+extern struct sakuc_deque *
+sakuc_deque_new_with_pool(size_t sub_deque_size, size_t elem_size, int behavior,
+                          struct sakuc_deque_pool *pool);
+
+/*  Same as #sakuc_deque_new, but the blocks grow geometrically with the deque: a new
+    block is about half as large as the deque, at least @sub_deque_size and at most
+    @max_sub_deque_size elements. So a small deque wastes little memory, and a big one
+    allocates (and walks) few blocks. nullptr returned if failed or
+    @max_sub_deque_size < @sub_deque_size.
+    
+    #sakuc_deque_at is O(number of blocks) instead of O(1) then.
+ */
+extern struct sakuc_deque *
+sakuc_deque_new_growing(size_t sub_deque_size, size_t max_sub_deque_size, size_t elem_size,
+                        int behavior);
+
+/*  Same as #sakuc_deque_new, but the blocks in memory are kept within @memory_budget
+    bytes by writing the middle ones to a spill file, an unnamed temporary file within
+    @spill_dir (nullptr - "/tmp"). Only the head and tail blocks are hot: the blocks
+    to spill are taken from the tail side, and the head reads the spilled ones back
+    SAKUC_DEQUE_SPILL_READ_AHEAD blocks ahead of itself (and asks the kernel to read
+    ahead as many more). The file space of blocks read back is reused, and the file
+    is truncated once nothing is spilled.
+    
+    The budget counts whole blocks; the head, its read-ahead and the tail blocks stay
+    in memory whatever the budget, and a spilled block still holds a header in memory.
+    Empty blocks are swept first when over the budget, whatever @behavior.
+    #sakuc_deque_at and the iterators read a spilled block back, pointers given by
+    them before may become invalid then.
+    
+    nullptr returned if failed, e.g. to create the file (linux only, always fails
+    elsewhere).
+ */
+extern struct sakuc_deque *
+sakuc_deque_new_spilling(size_t sub_deque_size, size_t elem_size, int behavior,
+                         size_t memory_budget, const char *spill_dir);
+
+/*  Initialize a deque within @dq provided by the caller (eg. on the stack), whose first
+    block lives in @storage (@storage_size bytes, at least SAKUC_DEQUE_INLINE_STORAGE_SIZE
+    of the final @sub_deque_size), so that it needs no memory allocation until it
+    outgrows that block. Blocks are allocated (and freed) only beyond it.
+    @storage nullptr - the first block is allocated as usual.
+    
+    -1 returned if failed or @storage is too small. @dq and @storage must not move
+    until #sakuc_deque_destroy, which doesn't free them.
+    
+    eg. struct sakuc_deque dq;
+        char storage[SAKUC_DEQUE_INLINE_STORAGE_SIZE(64, sizeof(void *))];
+        sakuc_deque_init(&dq, 64, sizeof(void *), SAKUC_DEQUE_SWEEP_MANUALLY,
+                         storage, sizeof(storage));
+ */
+extern int sakuc_deque_init(struct sakuc_deque *dq, size_t sub_deque_size, size_t elem_size,
+                            int behavior, void *storage, size_t storage_size);
+
+/*  New a pool of sub deques with @sub_deque_size elements of @elem_size bytes,
+    @low_watermark <= @high_watermark. nullptr returned if failed.
+ */
+extern struct sakuc_deque_pool *
+sakuc_deque_pool_new(size_t sub_deque_size, size_t elem_size,
+                     size_t low_watermark, size_t high_watermark);
+
+/* Free all the blocks kept in @pool, then @pool itself. -1 returned if failed. */
+extern int sakuc_deque_pool_destroy(struct sakuc_deque_pool *pool);
+
 extern int sakuc_deque_push_back(struct sakuc_deque *dq, const void *data, size_t len);
 
 extern int sakuc_deque_push_front(struct sakuc_deque *dq, const void *data, size_t len);
@@ -60,6 +206,76 @@ extern int sakuc_deque_pop_front(struct sakuc_deque *dq, void *data, size_t len)
 
 extern int sakuc_deque_sweep(struct sakuc_deque *dq, int behavior);
 
+/*  Pointer to the @i-th element (0 - front) within @dq, O(1) (refer to
+    #sakuc_deque_new_growing).
+    nullptr returned if @i >= sakuc_deque_size(dq).
+ */
+extern void *sakuc_deque_at(struct sakuc_deque *dq, size_t i);
+
+/* the front / back element in place, without popping it. nullptr returned if empty. */
+#define sakuc_deque_peek_front(dq) sakuc_deque_at((dq), 0)
+#define sakuc_deque_peek_back(dq) \
+    (sakuc_deque_size(dq) > 0 ? sakuc_deque_at((dq), sakuc_deque_size(dq) - 1) : nullptr)
+
+/*  Push the @n elements of @data (@n * @len bytes, @len equals to @dq->elem_size),
+    one memcpy per block. Return how many were pushed (< @n if failed to allocate).
+ */
+extern size_t sakuc_deque_push_back_n(struct sakuc_deque *dq, const void *data, size_t n,
+                                      size_t len);
+
+/*  popleft at most @n elements to @data (buffer with length @n * @len), one memcpy
+    per block. Return how many were popped, 0 if empty.
+ */
+extern size_t sakuc_deque_pop_front_n(struct sakuc_deque *dq, void *data, size_t n, size_t len);
+
+/*  Block-wise iteration from front to back, reading the elements in place:
+    
+        struct sakuc_deque_iter it;
+        void *elems;
+        size_t count;
+        sakuc_deque_iter_init(dq, &it);
+        while ((count = sakuc_deque_iter_next(&it, &elems)) > 0)
+            ... @count contiguous elements at @elems ...
+    
+    @dq must not be modified during the iteration.
+ */
+struct sakuc_deque_iter {
+    struct sakuc_deque *dq;
+    size_t block;       // index within @dq->map.
+    size_t pos;         // element index within that block.
+    size_t remaining;
+};
+
+extern void sakuc_deque_iter_init(struct sakuc_deque *dq, struct sakuc_deque_iter *iter);
+
+/* Return the number of contiguous elements at *@elems, 0 at the end. */
+extern size_t sakuc_deque_iter_next(struct sakuc_deque_iter *iter, void **elems);
+
+/*  Move the elements into as few blocks as they need (sized to fit, if the blocks
+    grow), and free all the other blocks, swept or not; the block map goes back
+    inline if it can. Pointers to the elements are invalidated.
+    -1 returned if failed to allocate memory, @dq is untouched then.
+ */
+extern int sakuc_deque_shrink_to_fit(struct sakuc_deque *dq);
+
+/* memory held by a deque, refer to #sakuc_deque_memory. */
+struct sakuc_deque_memory {
+    size_t num_blocks;      // blocks linked, swept or not (pooled ones excluded).
+    size_t capacity;        // elements the blocks can hold.
+    size_t used_bytes;      // of the elements, sakuc_deque_size() * elem_size.
+    size_t block_bytes;     // of the blocks in memory, headers included, but the inline block.
+    size_t map_bytes;       // of the block map if allocated, 0 if inline.
+    size_t num_spilled;     // blocks spilled to the file, refer to #sakuc_deque_new_spilling.
+    size_t spilled_bytes;   // of the elements within the file.
+    size_t total_bytes;     // allocated for @dq: block_bytes + map_bytes (+ the deque
+                            // itself if allocated by #sakuc_deque_new).
+};
+
+/*  Memory accounting, O(number of blocks). Fill @mem if not nullptr, and return
+    its @total_bytes. 0 returned if @dq is nullptr.
+ */
+extern size_t sakuc_deque_memory(struct sakuc_deque *dq, struct sakuc_deque_memory *mem);
+
 extern int sakuc_deque_destroy(struct sakuc_deque *dq);
 
 #define sakuc_deque_size(dq) ((dq)->length)
@@ -0,0 +1,113 @@
+// 2026-10-19 - bounded lock-free multi-producer/multi-consumer ringbuffer.
+
+#include "mpmc_ringbuffer.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+#define mpmc_slot_(rb, pos) ((char *)(rb)->buffer + ((pos) & (rb)->mask) * (rb)->slot_size)
+#define mpmc_slot_seq_(slot) ((size_t *)(slot))
+#define mpmc_slot_data_(slot) ((slot) + sizeof(size_t))
+
+mpmc_ringbuffer_t* mpmc_rbuf_new(size_t capacity, size_t elem_size)
+{
+    if (capacity == 0 || elem_size == 0)
+        return nullptr;
+    
+    // capacity 1 would make "full" (seq == pos + 1) and "free next lap" ambiguous.
+    size_t pow2 = 2;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    
+    mpmc_ringbuffer_t *rb = (mpmc_ringbuffer_t *)
+        osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, sizeof(mpmc_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    rb->slot_size = (sizeof(size_t) + elem_size + sizeof(size_t) - 1)
+                    / sizeof(size_t) * sizeof(size_t);
+    rb->buffer = osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, pow2 * rb->slot_size);
+    if (!rb->buffer) {
+        osal_mem_aligned_free(rb);
+        return nullptr;
+    }
+    
+    rb->capacity = pow2; rb->mask = pow2 - 1;
+    rb->block_size = elem_size;
+    rb->enqueue.pos = rb->dequeue.pos = 0;
+    for (size_t i = 0; i < pow2; i++)
+        *mpmc_slot_seq_(mpmc_slot_(rb, i)) = i;
+    
+    return rb;
+}
+
+int mpmc_rbuf_push_back(mpmc_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || !data || len != rb->block_size)
+        return -1;
+    
+    char *slot = nullptr;
+    size_t pos = osal_atomic_load_relaxed(&rb->enqueue.pos);
+    for (;;) {
+        slot = mpmc_slot_(rb, pos);
+        size_t seq = osal_atomic_load_acquire(mpmc_slot_seq_(slot));
+        intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+        
+        if (diff == 0) {
+            // free slot, try to claim it (@pos is reloaded if failed).
+            if (osal_atomic_cas_weak(&rb->enqueue.pos, &pos, pos + 1))
+                break;
+        }
+        else if (diff < 0)
+            return -1; // the slot of last lap has not been consumed yet - full.
+        else
+            pos = osal_atomic_load_relaxed(&rb->enqueue.pos);
+    }
+    
+    osal_memcpy(mpmc_slot_data_(slot), data, len);
+    osal_atomic_store_release(mpmc_slot_seq_(slot), pos + 1);
+    return 0;
+}
+
+void *mpmc_rbuf_pop_front(mpmc_ringbuffer_t *rb, void *pop_value, size_t len)
+{
+    if (!rb || !pop_value || len != rb->block_size)
+        return nullptr;
+    
+    char *slot = nullptr;
+    size_t pos = osal_atomic_load_relaxed(&rb->dequeue.pos);
+    for (;;) {
+        slot = mpmc_slot_(rb, pos);
+        size_t seq = osal_atomic_load_acquire(mpmc_slot_seq_(slot));
+        intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+        
+        if (diff == 0) {
+            if (osal_atomic_cas_weak(&rb->dequeue.pos, &pos, pos + 1))
+                break;
+        }
+        else if (diff < 0)
+            return nullptr; // not yet produced - empty.
+        else
+            pos = osal_atomic_load_relaxed(&rb->dequeue.pos);
+    }
+    
+    osal_memcpy(pop_value, mpmc_slot_data_(slot), len);
+    osal_atomic_store_release(mpmc_slot_seq_(slot), pos + rb->capacity);
+    return pop_value;
+}
+
+int mpmc_rbuf_destroy(mpmc_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->buffer))
+        return -1;
+    
+    osal_mem_aligned_free(rb->buffer);
+    osal_mem_aligned_free(rb);
+    return 0;
+}
+
+size_t mpmc_rbuf_length(mpmc_ringbuffer_t *rb)
+{
+    size_t dequeue_pos = osal_atomic_load_acquire(&rb->dequeue.pos);
+    size_t enqueue_pos = osal_atomic_load_acquire(&rb->enqueue.pos);
+    return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+}
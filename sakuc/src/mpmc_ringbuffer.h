@@ -0,0 +1,59 @@
+// 2026-10-19 - bounded lock-free multi-producer/multi-consumer ringbuffer.
+
+#ifndef SAKUC_MPMC_RINGBUFFER_H_
+#define SAKUC_MPMC_RINGBUFFER_H_
+
+#include "common_defs.h"
+
+/* Vyukov's bounded MPMC queue, reference:
+    http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+    
+   Every slot holds a @sequence followed by @block_size bytes of data:
+    sequence == pos          - slot is free, the producer claiming @pos may write it.
+    sequence == pos + 1      - slot is full, the consumer claiming @pos may read it.
+    sequence == pos + capacity - slot is free again for the next lap.
+   Producers (consumers) claim a position by CAS on @enqueue_pos (@dequeue_pos),
+   so they only contend with each other, never with the opposite side.
+ */
+struct mpmc_rbuf_pos_ {
+    size_t pos;
+    char pad[SAKUC_CACHE_LINE_SIZE - sizeof(size_t)];
+};
+
+typedef struct mpmc_ringbuffer {
+    // read-only after #mpmc_rbuf_new.
+    size_t capacity;    // power of 2.
+    size_t mask;        // capacity - 1.
+    size_t block_size;
+    size_t slot_size;   // sizeof(size_t) + block_size, rounded up to sizeof(size_t).
+    void *buffer;
+    char pad[SAKUC_CACHE_LINE_SIZE - 4 * sizeof(size_t) - sizeof(void *)];
+
+    struct mpmc_rbuf_pos_ enqueue;
+    struct mpmc_rbuf_pos_ dequeue;
+} mpmc_ringbuffer_t;
+
+/*  New a MPMC ringbuffer (FIFO), @capacity is rounded up to power of 2 (at least 2).
+    nullptr returned if failed to allocate memory.
+    
+    Any number of threads may push and pop concurrently. A full buffer is never
+    overwritten, #mpmc_rbuf_push_back fails instead.
+ */
+extern mpmc_ringbuffer_t* mpmc_rbuf_new(size_t capacity, size_t elem_size);
+
+/*  Push @data (with length @len) to @rb. -1 returned if failed or @rb is full.
+ */
+extern int mpmc_rbuf_push_back(mpmc_ringbuffer_t *rb, const void *data, size_t len);
+
+/*  popleft value to @pop_value (buffer with length @len which equals to @rb->block_size).
+    nullptr returned if @rb is empty.
+ */
+extern void *mpmc_rbuf_pop_front(mpmc_ringbuffer_t *rb, void *pop_value, size_t len);
+
+/* -1 returned if failed. No thread may use @rb any more. */
+extern int mpmc_rbuf_destroy(mpmc_ringbuffer_t *rb);
+
+/* approximate when used concurrently. */
+extern size_t mpmc_rbuf_length(mpmc_ringbuffer_t *rb);
+
+#endif // SAKUC_MPMC_RINGBUFFER_H_
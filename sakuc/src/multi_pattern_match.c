@@ -13,6 +13,14 @@
 #include "deque.h"
 #include "multi_pattern_match.h"
 
+/* The BFS queues below live on the stack, and so does their first block if
+   @fifo_init_size is at most MPM_FIFO_INLINE_SIZE: small automatons are walked
+   without touching the allocator.
+ */
+#define MPM_FIFO_INLINE_SIZE 64
+#define MPM_FIFO_INLINE_STORAGE \
+    SAKUC_DEQUE_INLINE_STORAGE_SIZE(MPM_FIFO_INLINE_SIZE, sizeof(pointer_trie_node_t))
+
 /* If initialize without ch then use _new_trie_node(0). */
 inline static struct trie_node * _new_trie_node(const char c)
 {
@@ -101,6 +109,10 @@ static int _print_deque_for_debug_only(struct sakuc_deque *dq)
 int sakuc_multi_pattern_build_search_automaton
         (struct trie_node **root, const char *keywords[], size_t num, size_t fifo_init_size)
 {
+    struct sakuc_deque bfs_queue;
+    char bfs_storage[MPM_FIFO_INLINE_STORAGE];
+    struct sakuc_deque *dq = nullptr;
+    
     build_assert(*root = _new_trie_node(0));
     (*root)->failover = *root;
     
@@ -138,9 +150,11 @@ int sakuc_multi_pattern_build_search_automaton
     
     // build the failover relationship based on the tree built just now, using BFS.
     
-    struct sakuc_deque *dq = nullptr;
-    build_assert(dq = sakuc_deque_new(fifo_init_size, sizeof(pointer_trie_node_t), 
-                                      SAKUC_DEQUE_SWEEP_MANUALLY));
+    build_assert(sakuc_deque_init(&bfs_queue, fifo_init_size, sizeof(pointer_trie_node_t),
+                                  SAKUC_DEQUE_SWEEP_MANUALLY,
+                                  fifo_init_size <= MPM_FIFO_INLINE_SIZE ? bfs_storage : nullptr,
+                                  sizeof(bfs_storage)) == 0);
+    dq = &bfs_queue;
     build_assert(sakuc_deque_push_back(dq, root, sizeof (pointer_trie_node_t)) == 0);
     _print_deque_for_debug_only(dq);
     
@@ -349,9 +363,14 @@ int sakuc_multi_pattern_destroy_search_automaton
     if (!root || fifo_init_size == 0)
         return -1;
     
-    struct sakuc_deque *dq = sakuc_deque_new(fifo_init_size, sizeof(struct trie_node *),
-                                             SAKUC_DEQUE_SWEEP_MANUALLY);
-    destroy_assert(dq);
+    struct sakuc_deque bfs_queue;
+    char bfs_storage[MPM_FIFO_INLINE_STORAGE];
+    struct sakuc_deque *dq = nullptr;
+    destroy_assert(sakuc_deque_init(&bfs_queue, fifo_init_size, sizeof(struct trie_node *),
+                                    SAKUC_DEQUE_SWEEP_MANUALLY,
+                                    fifo_init_size <= MPM_FIFO_INLINE_SIZE ? bfs_storage : nullptr,
+                                    sizeof(bfs_storage)) == 0);
+    dq = &bfs_queue;
     destroy_assert(sakuc_deque_push_back(dq, &root, sizeof(void *)) == 0);
     
     struct trie_node *curr_node = nullptr;
@@ -0,0 +1,160 @@
+// 2026-10-19 - byte-oriented ringbuffer of variable-length (length-prefixed) records.
+
+#include <stdint.h>
+#include "record_ringbuffer.h"
+#include "common_memory_management_defs.h"
+
+#define RECBUF_ALIGN 8
+#define RECBUF_SKIP UINT32_MAX  // header length of a skip marker.
+
+struct recbuf_header_ {
+    uint32_t len;       // payload length, or RECBUF_SKIP.
+    uint32_t reserved;
+};
+
+#define recbuf_align_(n) (((n) + RECBUF_ALIGN - 1) & ~(size_t) (RECBUF_ALIGN - 1))
+#define recbuf_record_size_(len) recbuf_align_(sizeof(struct recbuf_header_) + (len))
+#define recbuf_header_at_(rb, offset) \
+    ((struct recbuf_header_ *)((char *)(rb)->buffer + ((offset) & (rb)->mask)))
+
+record_ringbuffer_t* recbuf_new(size_t capacity, int policy)
+{
+    if (capacity < RECBUF_ALIGN
+        || (policy != RBUF_OVERFLOW_OVERWRITE && policy != RBUF_OVERFLOW_REJECT))
+        return nullptr;
+    
+    size_t pow2 = RECBUF_ALIGN;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    
+    record_ringbuffer_t *rb = (record_ringbuffer_t *) osal_mem_alloc(sizeof(record_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    rb->buffer = osal_mem_alloc(pow2);
+    if (!rb->buffer) {
+        osal_mem_free(rb);
+        return nullptr;
+    }
+    
+    rb->capacity = pow2; rb->mask = pow2 - 1;
+    rb->head = rb->tail = 0;
+    rb->length = 0;
+    rb->policy = policy;
+    return rb;
+}
+
+/* move @tail over a skip marker, if any. */
+static void recbuf_skip_marker_(record_ringbuffer_t *rb, size_t *tail)
+{
+    if (*tail != rb->head && recbuf_header_at_(rb, *tail)->len == RECBUF_SKIP)
+        *tail += rb->capacity - (*tail & rb->mask);
+}
+
+/* drop the oldest record, @rb must not be empty. */
+static void recbuf_drop_front_(record_ringbuffer_t *rb)
+{
+    recbuf_skip_marker_(rb, &rb->tail);
+    rb->tail += recbuf_record_size_(recbuf_header_at_(rb, rb->tail)->len);
+    -- rb->length;
+    recbuf_skip_marker_(rb, &rb->tail);
+}
+
+int recbuf_push_back(record_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || (!data && len > 0) || len >= RECBUF_SKIP)
+        return -1;
+    
+    size_t need = recbuf_record_size_(len);
+    if (need > rb->capacity)
+        return -1;
+    
+    for (;;) {
+        size_t contiguous = rb->capacity - (rb->head & rb->mask);
+        size_t total = need + (contiguous < need ? contiguous : 0); // with the skip marker.
+        
+        if (rb->capacity - recbuf_bytes(rb) >= total)
+            break;
+        
+        if (rb->length == 0) {
+            // empty but the free room is split by the end of buffer, start over at 0.
+            rb->head += contiguous;
+            rb->tail = rb->head;
+            continue;
+        }
+        if (rb->policy == RBUF_OVERFLOW_REJECT)
+            return -1;
+        recbuf_drop_front_(rb);
+    }
+    
+    size_t contiguous = rb->capacity - (rb->head & rb->mask);
+    if (contiguous < need) {
+        // @contiguous is a multiple of RECBUF_ALIGN, so the marker header always fits.
+        recbuf_header_at_(rb, rb->head)->len = RECBUF_SKIP;
+        rb->head += contiguous;
+    }
+    
+    struct recbuf_header_ *header = recbuf_header_at_(rb, rb->head);
+    header->len = (uint32_t) len;
+    header->reserved = 0;
+    if (len > 0)
+        osal_memcpy(header + 1, data, len);
+    rb->head += need;
+    ++ rb->length;
+    return 0;
+}
+
+void *recbuf_pop_front(record_ringbuffer_t *rb, void *buf, size_t *len)
+{
+    if (!rb || !len || rb->length == 0)
+        return nullptr;
+    
+    recbuf_skip_marker_(rb, &rb->tail);
+    struct recbuf_header_ *header = recbuf_header_at_(rb, rb->tail);
+    if (!buf || *len < header->len) {
+        *len = header->len;
+        return nullptr;
+    }
+    
+    *len = header->len;
+    osal_memcpy(buf, header + 1, header->len);
+    recbuf_drop_front_(rb);
+    return buf;
+}
+
+size_t recbuf_peek_batch(record_ringbuffer_t *rb, struct recbuf_record records[], size_t max)
+{
+    if (!rb || !records)
+        return 0;
+    
+    size_t n = 0;
+    size_t tail = rb->tail;
+    for (; n < max && n < rb->length; n++) {
+        recbuf_skip_marker_(rb, &tail);
+        struct recbuf_header_ *header = recbuf_header_at_(rb, tail);
+        records[n].data = header + 1;
+        records[n].len = header->len;
+        tail += recbuf_record_size_(header->len);
+    }
+    return n;
+}
+
+int recbuf_consume(record_ringbuffer_t *rb, size_t n)
+{
+    if (!rb || n > rb->length)
+        return -1;
+    
+    while (n-- > 0)
+        recbuf_drop_front_(rb);
+    return 0;
+}
+
+int recbuf_destroy(record_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->buffer))
+        return -1;
+    
+    osal_mem_free(rb->buffer);
+    osal_mem_free(rb);
+    return 0;
+}
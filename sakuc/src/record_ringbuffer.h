@@ -0,0 +1,64 @@
+// 2026-10-19 - byte-oriented ringbuffer of variable-length (length-prefixed) records.
+
+#ifndef SAKUC_RECORD_RINGBUFFER_H_
+#define SAKUC_RECORD_RINGBUFFER_H_
+
+#include "common_defs.h"
+#include "ringbuffer.h" // enum rbuf_overflow_policy
+
+/*  Records are stored as a 8 bytes header (payload length) followed by the
+    payload, padded to 8 bytes, so memory use scales with the actual payload
+    instead of a worst-case @block_size. A record is never split: when it does not
+    fit before the end of @buffer, a skip marker fills the rest and the record
+    starts over at the beginning, so every record can be read in place.
+ */
+typedef struct record_ringbuffer {
+    size_t capacity;    // bytes, power of 2.
+    size_t mask;        // capacity - 1.
+    size_t head;        // free-running byte offset, next record is written there.
+    size_t tail;        // free-running byte offset, oldest record (or skip marker).
+    size_t length;      // number of records.
+    int policy;         // RBUF_OVERFLOW_OVERWRITE or RBUF_OVERFLOW_REJECT.
+    void *buffer;
+} record_ringbuffer_t;
+
+/* A record read in place, refer to #recbuf_peek_batch. */
+struct recbuf_record {
+    const void *data;
+    size_t len;
+};
+
+/*  New a record ringbuffer of @capacity bytes (rounded up to power of 2).
+    @policy - RBUF_OVERFLOW_OVERWRITE drops the oldest records to make room,
+              RBUF_OVERFLOW_REJECT fails the push.
+    nullptr returned if failed.
+ */
+extern record_ringbuffer_t* recbuf_new(size_t capacity, int policy);
+
+/*  Push a record of @len bytes. -1 returned if failed, the record can never fit,
+    or @rb is full under RBUF_OVERFLOW_REJECT.
+ */
+extern int recbuf_push_back(record_ringbuffer_t *rb, const void *data, size_t len);
+
+/*  popleft the oldest record into @buf. @len - in: size of @buf, out: record length.
+    nullptr returned if @rb is empty, or if @buf is too small (the record stays,
+    @len is set to the size needed).
+ */
+extern void *recbuf_pop_front(record_ringbuffer_t *rb, void *buf, size_t *len);
+
+/*  Batch read: describe at most @max oldest records in place, without removing
+    them. Return how many records are described; release them with #recbuf_consume.
+ */
+extern size_t recbuf_peek_batch(record_ringbuffer_t *rb, struct recbuf_record records[],
+                                size_t max);
+
+/*  Drop the @n oldest records (@n <= recbuf_length). -1 returned if failed. */
+extern int recbuf_consume(record_ringbuffer_t *rb, size_t n);
+
+/* -1 returned if failed. */
+extern int recbuf_destroy(record_ringbuffer_t *rb);
+
+#define recbuf_length(rb) ((rb)->length)
+#define recbuf_bytes(rb) ((rb)->head - (rb)->tail)
+
+#endif // SAKUC_RECORD_RINGBUFFER_H_
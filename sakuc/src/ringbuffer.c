@@ -1,14 +1,82 @@
 // 2013-7-13, jtuki@foxmail.com
 
+#define _GNU_SOURCE // pthread_condattr_setclock, eventfd, memfd_create.
+
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#endif
+
 #include "ringbuffer.h"
 #include "common_memory_management_defs.h"
 
+/* Only allocated for RBUF_OVERFLOW_BLOCK ringbuffers. */
+struct rbuf_sync_ {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;   // consumers wait on it.
+    pthread_cond_t not_full;    // producers wait on it.
+    
+    // batched wakeups: at most one signal is outstanding on each condition, and
+    // consumers are only signaled once @wakeup_batch elements are available.
+    size_t empty_waiters; int empty_signaled;
+    size_t full_waiters; int full_signaled;
+    size_t wakeup_batch;
+    
+    int eventfd;    // -1 if not created by #rbuf_eventfd.
+};
+
 /*  New a struct rbufStruct (FIFO).
     @param capacity - capacity of the ringbuffer.
     @param elem_size - size of a single element.
  */
 ringbuffer_t* rbuf_new(size_t capacity, size_t elem_size)
 {
+    return rbuf_new_with_policy(capacity, elem_size, RBUF_OVERFLOW_OVERWRITE);
+}
+
+static struct rbuf_sync_ *rbuf_sync_new_(void)
+{
+    struct rbuf_sync_ *sync = (struct rbuf_sync_ *) osal_mem_calloc(1, sizeof(struct rbuf_sync_));
+    if (!sync)
+        return nullptr;
+    
+    // timed waits are measured with CLOCK_MONOTONIC, immune to wall clock changes.
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    
+    pthread_mutex_init(&sync->lock, nullptr);
+    pthread_cond_init(&sync->not_empty, &attr);
+    pthread_cond_init(&sync->not_full, &attr);
+    pthread_condattr_destroy(&attr);
+    
+    sync->wakeup_batch = 1;
+    sync->eventfd = -1;
+    return sync;
+}
+
+static void rbuf_sync_destroy_(struct rbuf_sync_ *sync)
+{
+    pthread_cond_destroy(&sync->not_full);
+    pthread_cond_destroy(&sync->not_empty);
+    pthread_mutex_destroy(&sync->lock);
+    if (sync->eventfd >= 0)
+        close(sync->eventfd);
+    osal_mem_free(sync);
+}
+
+ringbuffer_t* rbuf_new_with_policy(size_t capacity, size_t elem_size, int policy)
+{
+    if (policy != RBUF_OVERFLOW_OVERWRITE && policy != RBUF_OVERFLOW_REJECT
+        && policy != RBUF_OVERFLOW_BLOCK)
+        return nullptr;
+    
     ringbuffer_t *rb = (ringbuffer_t *) osal_mem_alloc(sizeof(ringbuffer_t));
     if (!rb)
         return nullptr;
@@ -18,14 +86,206 @@ ringbuffer_t* rbuf_new(size_t capacity, size_t elem_size)
         osal_mem_free(rb);
         return nullptr;
     }
+    
+    rb->policy = policy;
+    rb->mirrored = FALSE;
+    rb->sync = nullptr;
+    if (policy == RBUF_OVERFLOW_BLOCK && !(rb->sync = rbuf_sync_new_())) {
+        osal_mem_free(rb->buffer);
+        osal_mem_free(rb);
+        return nullptr;
+    }
 
     rb->start = 0; rb->end = 0;
     rb->block_size = elem_size;
     rb->capacity = capacity; rb->length = 0;
+    rb->partial_in = 0; rb->partial_out = 0;
+    rb->fd_busy = 0;
+    
+    return rb;
+}
+
+#ifdef __linux__
+static size_t gcd_(size_t a, size_t b)
+{
+    while (b) {
+        size_t t = a % b;
+        a = b; b = t;
+    }
+    return a;
+}
+
+/* map @size bytes of a memfd twice, back to back. nullptr returned if failed. */
+static void *rbuf_map_mirrored_(size_t size)
+{
+    int fd = memfd_create("sakuc_ringbuffer", MFD_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    
+    // reserve the whole range first, so that both halves land back to back.
+    char *base = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+        || mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)
+           == MAP_FAILED)
+    {
+        munmap(base, 2 * size);
+        close(fd);
+        return nullptr;
+    }
+    
+    close(fd); // the mappings keep the pages alive.
+    return base;
+}
+#endif
+
+ringbuffer_t* rbuf_new_mirrored(size_t capacity, size_t elem_size, int policy)
+{
+#ifdef __linux__
+    if (capacity == 0 || elem_size == 0)
+        return nullptr;
+    
+    size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    size_t unit = page_size / gcd_(page_size, elem_size); // elements per page-aligned unit.
+    capacity = (capacity + unit - 1) / unit * unit;
     
+    // allocate a 1-element ring, then swap its buffer for the mirrored mapping.
+    ringbuffer_t *rb = rbuf_new_with_policy(1, elem_size, policy);
+    if (!rb)
+        return nullptr;
+    
+    void *buffer = rbuf_map_mirrored_(capacity * elem_size);
+    if (!buffer) {
+        rbuf_destroy(rb);
+        return nullptr;
+    }
+    osal_mem_free(rb->buffer);
+    rb->buffer = buffer;
+    rb->capacity = capacity;
+    rb->mirrored = TRUE;
     return rb;
+#else
+    return nullptr;
+#endif
+}
+
+#define rbuf_lock_(rb) do {                                 \
+    if ((rb)->sync)                                         \
+        pthread_mutex_lock(&(rb)->sync->lock);              \
+} while (__LINE__ == -1)
+
+#define rbuf_unlock_(rb) do {                               \
+    if ((rb)->sync)                                         \
+        pthread_mutex_unlock(&(rb)->sync->lock);            \
+} while (__LINE__ == -1)
+
+/*  Called with the lock held after elements were added (@old_length before).
+    Wake one sleeping consumer and the eventfd once the wakeup batch is reached.
+ */
+static void rbuf_notify_consumers_(ringbuffer_t *rb, size_t old_length)
+{
+    struct rbuf_sync_ *sync = rb->sync;
+    if (!sync || rb->length < sync->wakeup_batch)
+        return;
+    
+    if (sync->empty_waiters > 0 && !sync->empty_signaled) {
+        sync->empty_signaled = TRUE;
+        pthread_cond_signal(&sync->not_empty);
+    }
+    if (sync->eventfd >= 0 && old_length < sync->wakeup_batch) {
+        uint64_t one = 1;
+        ssize_t ret = write(sync->eventfd, &one, sizeof(one));
+        (void) ret; // EAGAIN - the counter is already non-zero, fine.
+    }
+}
+
+/*  Called with the lock held. Wake one sleeping producer if there is room; it
+    passes the wakeup on after its push, so that freeing several slots at once
+    wakes as many producers as there is room for.
+ */
+static void rbuf_wake_producer_(ringbuffer_t *rb)
+{
+    struct rbuf_sync_ *sync = rb->sync;
+    if (sync && sync->full_waiters > 0 && !sync->full_signaled && rb->length < rb->capacity) {
+        sync->full_signaled = TRUE;
+        pthread_cond_signal(&sync->not_full);
+    }
+}
+
+/* Called with the lock held after elements were removed. */
+static void rbuf_notify_producers_(ringbuffer_t *rb)
+{
+    if (!rb->sync)
+        return;
+    
+    rbuf_wake_producer_(rb);
+    // chain the wakeup if there is still enough for another sleeping consumer, and
+    // re-arm the eventfd: the consumer read it before popping part of the batch only.
+    rbuf_notify_consumers_(rb, 0);
+}
+
+/* absolute CLOCK_MONOTONIC deadline @timeout_ms milliseconds from now. */
+static void rbuf_deadline_(struct timespec *deadline, int timeout_ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (long) (timeout_ms % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000L;
+    }
 }
 
+/*  Called with the lock held. Wait until @rb has at least @want elements
+    (consumer, @want_room FALSE) or at least one free slot (producer, @want_room TRUE).
+    0 returned if the condition holds, -1 if timeout or @rb cannot block.
+ */
+static int rbuf_wait_(ringbuffer_t *rb, int want_room, size_t want, int timeout_ms)
+{
+    struct rbuf_sync_ *sync = rb->sync;
+    struct timespec deadline;
+    
+#define rbuf_wait_done_() (want_room ? rb->length < rb->capacity : rb->length >= want)
+    
+    if (rbuf_wait_done_())
+        return 0;
+    if (!sync || timeout_ms == 0)
+        return -1;
+    if (timeout_ms > 0)
+        rbuf_deadline_(&deadline, timeout_ms);
+    
+    pthread_cond_t *cond = want_room ? &sync->not_full : &sync->not_empty;
+    size_t *waiters = want_room ? &sync->full_waiters : &sync->empty_waiters;
+    int *signaled = want_room ? &sync->full_signaled : &sync->empty_signaled;
+    
+    while (!rbuf_wait_done_()) {
+        ++ *waiters;
+        int ret = (timeout_ms > 0) ? pthread_cond_timedwait(cond, &sync->lock, &deadline)
+                                   : pthread_cond_wait(cond, &sync->lock);
+        -- *waiters;
+        *signaled = FALSE;
+        
+        if (ret == ETIMEDOUT)
+            return rbuf_wait_done_() ? 0 : -1;
+    }
+    return 0;
+    
+#undef rbuf_wait_done_
+}
+
+/*  The back (front) is owned by #rbuf_read_fd (#rbuf_write_fd): it is in the
+    syscall, or a partial element is pending.
+ */
+#define rbuf_back_busy_(rb) ((rb)->partial_in > 0 || ((rb)->fd_busy & RBUF_FD_READING))
+#define rbuf_front_busy_(rb) ((rb)->partial_out > 0 || ((rb)->fd_busy & RBUF_FD_WRITING))
+
 #define AdvanceIndex(index, capacity)                       \
     do {                                                    \
         index += 1;                                         \
@@ -33,17 +293,19 @@ ringbuffer_t* rbuf_new(size_t capacity, size_t elem_size)
             (index) = 0;                                    \
     } while(__LINE__ == -1)
 
-int rbuf_push_back(ringbuffer_t *rb, void *data, size_t len)
+/*  push one element, the lock (if any) is held. -1 returned if full and not
+    overwriting, or the back is busy.
+ */
+static int rbuf_push_one_(ringbuffer_t *rb, const void *data)
 {
-    if (!rb || !data
-        || len != rb->block_size)
+    if (rbuf_back_busy_(rb))
+        return -1;
+    if (rb->length == rb->capacity
+        && (rb->policy != RBUF_OVERFLOW_OVERWRITE || rbuf_front_busy_(rb)))
         return -1;
     
     char *rbuf = rb->buffer;
-    if (!rbuf)
-      return -1;
-
-    osal_memcpy(rbuf + rb->end * rb->block_size, data, len);
+    osal_memcpy(rbuf + rb->end * rb->block_size, data, rb->block_size);
     AdvanceIndex(rb->end, rb->capacity);
 
     if (rb->length == rb->capacity) {
@@ -55,19 +317,43 @@ int rbuf_push_back(ringbuffer_t *rb, void *data, size_t len)
     return 0;
 }
 
-void *rbuf_pop_front(ringbuffer_t *rb, void *pop_value, size_t len)
+int rbuf_push_back(ringbuffer_t *rb, void *data, size_t len)
 {
-    if (!rb || !pop_value
+    return rbuf_push_back_timed(rb, data, len, -1);
+}
+
+int rbuf_push_back_timed(ringbuffer_t *rb, const void *data, size_t len, int timeout_ms)
+{
+    if (!rb || !data
         || len != rb->block_size)
-        return 0;
+        return -1;
     
     char *rbuf = rb->buffer;
     if (!rbuf)
-      return 0;
+      return -1;
+    
+    if (!rb->sync)
+        return rbuf_push_one_(rb, data);
+    
+    int ret = -1;
+    rbuf_lock_(rb);
+    if (rbuf_wait_(rb, TRUE, 1, timeout_ms) == 0) {
+        size_t old_length = rb->length;
+        ret = rbuf_push_one_(rb, data);
+        rbuf_notify_consumers_(rb, old_length);
+        rbuf_wake_producer_(rb);
+    }
+    rbuf_unlock_(rb);
+    return ret;
+}
 
+/* pop one element, the lock (if any) is held. nullptr returned if empty or the front is busy. */
+static void *rbuf_pop_one_(ringbuffer_t *rb, void *pop_value)
+{
     // empty FIFO, nothing pop out.
-    if (rb->length > 0) {
-        osal_memcpy(pop_value, rbuf + rb->start * len, len);
+    if (rb->length > 0 && !rbuf_front_busy_(rb)) {
+        char *rbuf = rb->buffer;
+        osal_memcpy(pop_value, rbuf + rb->start * rb->block_size, rb->block_size);
         AdvanceIndex(rb->start, rb->capacity);
 
         rb->length -= 1;
@@ -77,12 +363,377 @@ void *rbuf_pop_front(ringbuffer_t *rb, void *pop_value, size_t len)
     return nullptr;
 }
 
+void *rbuf_pop_front(ringbuffer_t *rb, void *pop_value, size_t len)
+{
+    return rbuf_pop_front_timed(rb, pop_value, len, 0);
+}
+
+void *rbuf_pop_front_timed(ringbuffer_t *rb, void *pop_value, size_t len, int timeout_ms)
+{
+    if (!rb || !pop_value
+        || len != rb->block_size)
+        return 0;
+    
+    char *rbuf = rb->buffer;
+    if (!rbuf)
+      return 0;
+    
+    if (!rb->sync)
+        return rbuf_pop_one_(rb, pop_value);
+    
+    rbuf_lock_(rb);
+    rbuf_wait_(rb, FALSE, rb->sync->wakeup_batch, timeout_ms);
+    void *ret = rbuf_pop_one_(rb, pop_value);
+    if (ret)
+        rbuf_notify_producers_(rb);
+    rbuf_unlock_(rb);
+    return ret;
+}
+
+/* copy @n elements from @src into @rb, starting at slot @index, wrap if needed. */
+static void rbuf_copy_in_(ringbuffer_t *rb, size_t index, const char *src, size_t n)
+{
+    size_t first = rb->capacity - index; // room before the wrap point.
+    if (first > n || rb->mirrored)
+        first = n;
+    
+    osal_memcpy((char *)rb->buffer + index * rb->block_size, src, first * rb->block_size);
+    if (n > first)
+        osal_memcpy(rb->buffer, src + first * rb->block_size, (n - first) * rb->block_size);
+}
+
+/* copy @n elements out of @rb into @dst, starting at slot @index, wrap if needed. */
+static void rbuf_copy_out_(ringbuffer_t *rb, size_t index, char *dst, size_t n)
+{
+    size_t first = rb->capacity - index;
+    if (first > n || rb->mirrored)
+        first = n;
+    
+    osal_memcpy(dst, (char *)rb->buffer + index * rb->block_size, first * rb->block_size);
+    if (n > first)
+        osal_memcpy(dst + first * rb->block_size, rb->buffer, (n - first) * rb->block_size);
+}
+
+size_t rbuf_push_back_n(ringbuffer_t *rb, const void *data, size_t n, size_t len,
+                        int overwrite)
+{
+    if (!rb || !data || !rb->buffer
+        || len != rb->block_size)
+        return 0;
+    
+    // only RBUF_OVERFLOW_OVERWRITE ringbuffers may lose unread data.
+    if (rb->policy != RBUF_OVERFLOW_OVERWRITE)
+        overwrite = FALSE;
+    
+    rbuf_lock_(rb);
+    size_t old_length = rb->length;
+    size_t skip = 0; // elements of @data which would be overwritten by @data itself.
+    size_t m = n;    // elements to be copied.
+    
+    if (rbuf_back_busy_(rb)) {
+        rbuf_unlock_(rb);
+        return 0;
+    }
+    if (rbuf_front_busy_(rb))
+        overwrite = FALSE;
+    if (overwrite) {
+        if (n > rb->capacity) {
+            skip = n - rb->capacity;
+            m = rb->capacity;
+        }
+    }
+    else if (m > rb->capacity - rb->length) {
+        m = rb->capacity - rb->length;
+    }
+    
+    if (m > 0) {
+        size_t index = (rb->end + skip) % rb->capacity;
+        rbuf_copy_in_(rb, index, (const char *)data + skip * len, m);
+        
+        rb->end = (index + m) % rb->capacity;
+        if (rb->length + m >= rb->capacity) {
+            rb->length = rb->capacity;
+            rb->start = rb->end;
+        }
+        else {
+            rb->length += m;
+        }
+        rbuf_notify_consumers_(rb, old_length);
+    }
+    rbuf_unlock_(rb);
+    
+    return (m == 0 && !overwrite) ? 0 : skip + m;
+}
+
+/* pop at most @n elements, the lock (if any) is held. */
+static size_t rbuf_pop_n_(ringbuffer_t *rb, void *pop_values, size_t n)
+{
+    if (rbuf_front_busy_(rb))
+        return 0;
+    if (n > rb->length)
+        n = rb->length;
+    if (n == 0)
+        return 0;
+    
+    rbuf_copy_out_(rb, rb->start, pop_values, n);
+    rb->start = (rb->start + n) % rb->capacity;
+    rb->length -= n;
+    rbuf_notify_producers_(rb);
+    return n;
+}
+
+size_t rbuf_pop_front_n(ringbuffer_t *rb, void *pop_values, size_t n, size_t len)
+{
+    return rbuf_pop_front_n_timed(rb, pop_values, n, len, 0);
+}
+
+size_t rbuf_pop_front_n_timed(ringbuffer_t *rb, void *pop_values, size_t n, size_t len,
+                              int timeout_ms)
+{
+    if (!rb || !pop_values || !rb->buffer
+        || len != rb->block_size)
+        return 0;
+    
+    rbuf_lock_(rb);
+    if (rb->sync)
+        rbuf_wait_(rb, FALSE, rb->sync->wakeup_batch, timeout_ms);
+    n = rbuf_pop_n_(rb, pop_values, n);
+    rbuf_unlock_(rb);
+    return n;
+}
+
+int rbuf_set_wakeup_batch(ringbuffer_t *rb, size_t batch)
+{
+    if (!rb || !rb->sync || batch == 0 || batch > rb->capacity)
+        return -1;
+    
+    rbuf_lock_(rb);
+    rb->sync->wakeup_batch = batch;
+    rbuf_notify_consumers_(rb, 0);
+    rbuf_unlock_(rb);
+    return 0;
+}
+
+int rbuf_eventfd(ringbuffer_t *rb)
+{
+    if (!rb || !rb->sync)
+        return -1;
+    
+#ifdef __linux__
+    rbuf_lock_(rb);
+    if (rb->sync->eventfd < 0) {
+        rb->sync->eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        // data might be already there.
+        if (rb->sync->eventfd >= 0)
+            rbuf_notify_consumers_(rb, 0);
+    }
+    int fd = rb->sync->eventfd;
+    rbuf_unlock_(rb);
+    return fd;
+#else
+    return -1;
+#endif
+}
+
+/* describe @n elements starting at slot @index by one or two regions. */
+static void rbuf_regions_(ringbuffer_t *rb, size_t index, size_t n, struct rbuf_region regions[2])
+{
+    size_t first = rb->capacity - index;
+    if (first > n || rb->mirrored)
+        first = n;
+    
+    regions[0].data = (char *)rb->buffer + index * rb->block_size;
+    regions[0].count = first;
+    regions[1].data = rb->buffer;
+    regions[1].count = n - first;
+}
+
+size_t rbuf_reserve_back(ringbuffer_t *rb, size_t n, struct rbuf_region regions[2])
+{
+    if (!rb || !regions || !rb->buffer)
+        return 0;
+    
+    rbuf_lock_(rb);
+    if (rbuf_back_busy_(rb))
+        n = 0;
+    else if (n > rb->capacity - rb->length)
+        n = rb->capacity - rb->length;
+    
+    rbuf_regions_(rb, rb->end, n, regions);
+    rbuf_unlock_(rb);
+    return n;
+}
+
+int rbuf_commit_back(ringbuffer_t *rb, size_t n)
+{
+    if (!rb)
+        return -1;
+    
+    int ret = -1;
+    rbuf_lock_(rb);
+    if (!rbuf_back_busy_(rb) && n <= rb->capacity - rb->length) {
+        size_t old_length = rb->length;
+        rb->end = (rb->end + n) % rb->capacity;
+        rb->length += n;
+        rbuf_notify_consumers_(rb, old_length);
+        ret = 0;
+    }
+    rbuf_unlock_(rb);
+    return ret;
+}
+
+size_t rbuf_peek_front(ringbuffer_t *rb, size_t n, struct rbuf_region regions[2])
+{
+    if (!rb || !regions || !rb->buffer)
+        return 0;
+    
+    rbuf_lock_(rb);
+    if (rbuf_front_busy_(rb))
+        n = 0;
+    else if (n > rb->length)
+        n = rb->length;
+    
+    rbuf_regions_(rb, rb->start, n, regions);
+    rbuf_unlock_(rb);
+    return n;
+}
+
+int rbuf_consume_front(ringbuffer_t *rb, size_t n)
+{
+    if (!rb)
+        return -1;
+    
+    int ret = -1;
+    rbuf_lock_(rb);
+    if (!rbuf_front_busy_(rb) && n <= rb->length) {
+        rb->start = (rb->start + n) % rb->capacity;
+        rb->length -= n;
+        rbuf_notify_producers_(rb);
+        ret = 0;
+    }
+    rbuf_unlock_(rb);
+    return ret;
+}
+
+/*  iovecs of @n elements starting at slot @index, skipping the first @skip bytes.
+    Return the number of iovecs used (0 ~ 2).
+ */
+static int rbuf_iovecs_(ringbuffer_t *rb, size_t index, size_t n, size_t skip,
+                        struct iovec iov[2])
+{
+    struct rbuf_region regions[2];
+    rbuf_regions_(rb, index, n, regions);
+    if (n == 0)
+        return 0;
+    
+    iov[0].iov_base = (char *)regions[0].data + skip;
+    iov[0].iov_len = regions[0].count * rb->block_size - skip;
+    iov[1].iov_base = regions[1].data;
+    iov[1].iov_len = regions[1].count * rb->block_size;
+    return regions[1].count > 0 ? 2 : 1;
+}
+
+ssize_t rbuf_read_fd(ringbuffer_t *rb, int fd)
+{
+    if (!rb || !rb->buffer || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    
+    struct iovec iov[2];
+    rbuf_lock_(rb);
+    if (rb->fd_busy & RBUF_FD_READING) {
+        rbuf_unlock_(rb);
+        errno = EBUSY;
+        return -1;
+    }
+    int iovcnt = rbuf_iovecs_(rb, rb->end, rb->capacity - rb->length, rb->partial_in, iov);
+    if (iovcnt == 0) {
+        rbuf_unlock_(rb);
+        errno = ENOBUFS;
+        return -1;
+    }
+    
+    // the free room stays ours without the lock: consumers only add to it.
+    rb->fd_busy |= RBUF_FD_READING;
+    rbuf_unlock_(rb);
+    ssize_t ret = readv(fd, iov, iovcnt);
+    int saved_errno = errno;
+    rbuf_lock_(rb);
+    rb->fd_busy &= ~RBUF_FD_READING;
+    
+    if (ret > 0) {
+        size_t bytes = rb->partial_in + (size_t) ret;
+        size_t n = bytes / rb->block_size;
+        size_t old_length = rb->length;
+        
+        rb->partial_in = bytes % rb->block_size;
+        rb->end = (rb->end + n) % rb->capacity;
+        rb->length += n;
+        if (n > 0)
+            rbuf_notify_consumers_(rb, old_length);
+    }
+    rbuf_unlock_(rb);
+    errno = saved_errno;
+    return ret;
+}
+
+ssize_t rbuf_write_fd(ringbuffer_t *rb, int fd)
+{
+    if (!rb || !rb->buffer || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    
+    struct iovec iov[2];
+    rbuf_lock_(rb);
+    if (rb->fd_busy & RBUF_FD_WRITING) {
+        rbuf_unlock_(rb);
+        errno = EBUSY;
+        return -1;
+    }
+    int iovcnt = rbuf_iovecs_(rb, rb->start, rb->length, rb->partial_out, iov);
+    if (iovcnt == 0) {
+        rbuf_unlock_(rb);
+        return 0;
+    }
+    
+    // the occupied elements stay ours without the lock: producers only append.
+    rb->fd_busy |= RBUF_FD_WRITING;
+    rbuf_unlock_(rb);
+    ssize_t ret = writev(fd, iov, iovcnt);
+    int saved_errno = errno;
+    rbuf_lock_(rb);
+    rb->fd_busy &= ~RBUF_FD_WRITING;
+    
+    if (ret > 0) {
+        size_t bytes = rb->partial_out + (size_t) ret;
+        size_t n = bytes / rb->block_size;
+        
+        rb->partial_out = bytes % rb->block_size;
+        rb->start = (rb->start + n) % rb->capacity;
+        rb->length -= n;
+        if (n > 0)
+            rbuf_notify_producers_(rb);
+    }
+    rbuf_unlock_(rb);
+    errno = saved_errno;
+    return ret;
+}
+
 int rbuf_destroy(ringbuffer_t *rb)
 {
     if (!rb || !(rb->buffer))
       return -1;
     
-    osal_mem_free(rb->buffer);
+    if (rb->sync)
+        rbuf_sync_destroy_(rb->sync);
+#ifdef __linux__
+    if (rb->mirrored)
+        munmap(rb->buffer, 2 * rb->capacity * rb->block_size);
+    else
+#endif
+        osal_mem_free(rb->buffer);
     osal_mem_free(rb);
     return 0;
 }
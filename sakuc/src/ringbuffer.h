@@ -3,8 +3,18 @@
 #ifndef SAKUC_RINGBUFFER_H_
 #define SAKUC_RINGBUFFER_H_
 
+#include <sys/types.h>
 #include "common_defs.h"
 
+/* What #rbuf_push_back does when the ringbuffer is full, refer to #rbuf_new_with_policy. */
+enum rbuf_overflow_policy {
+    RBUF_OVERFLOW_OVERWRITE = 0,    // overwrite the oldest element (#rbuf_new).
+    RBUF_OVERFLOW_REJECT = 1,       // fail (-1 returned).
+    RBUF_OVERFLOW_BLOCK = 2,        // wait for room, the ringbuffer is thread-safe.
+};
+
+struct rbuf_sync_; // mutex & condition variables, only for RBUF_OVERFLOW_BLOCK.
+
 typedef struct ringbuffer {
     // size: capacity of ringbuffer.
     size_t capacity;
@@ -15,21 +25,161 @@ typedef struct ringbuffer {
     // @start and @end - 0~(capacity-1)
     size_t start; size_t end;
     void *buffer;
+    // enum rbuf_overflow_policy.
+    int policy;
+    // nullptr unless @policy is RBUF_OVERFLOW_BLOCK.
+    struct rbuf_sync_ *sync;
+    // TRUE if @buffer is mapped twice back to back, refer to #rbuf_new_mirrored.
+    int mirrored;
+    // bytes of the element at @end already received by #rbuf_read_fd (not counted
+    // in @length yet), and bytes of the element at @start already sent by #rbuf_write_fd.
+    size_t partial_in; size_t partial_out;
+    // RBUF_FD_READING / RBUF_FD_WRITING while #rbuf_read_fd / #rbuf_write_fd is in the
+    // syscall (without the lock).
+    int fd_busy;
 } ringbuffer_t;
 
 /*  New a struct ringbuffer_t (FIFO). nullptr returned if failed to allocate memory.
+    Same as #rbuf_new_with_policy(capacity, elem_size, RBUF_OVERFLOW_OVERWRITE).
  */
 extern ringbuffer_t* rbuf_new(size_t capacity, size_t elem_size);
 
+/*  New a struct ringbuffer_t (FIFO) with overflow @policy (enum rbuf_overflow_policy).
+    nullptr returned if failed.
+    
+    A RBUF_OVERFLOW_BLOCK ringbuffer is protected by an internal mutex, so that any
+    thread may call the push/pop/reserve/peek functions below, and producers or
+    consumers can sleep in #rbuf_push_back_timed / #rbuf_pop_front_timed instead of
+    spinning. Other ringbuffers are not synchronized at all.
+ */
+extern ringbuffer_t* rbuf_new_with_policy(size_t capacity, size_t elem_size, int policy);
+
+/*  New a struct ringbuffer_t whose @buffer is followed in virtual memory by a
+    second mapping of the same (memfd-backed) pages, linux only.
+    nullptr returned if failed.
+    
+    Any run of up to @capacity elements starting at any slot is then contiguous,
+    so #rbuf_reserve_back and #rbuf_peek_front always describe a single region,
+    and the contents can be handed to parsers or the multi-pattern matcher as is.
+    @capacity is rounded up so that @capacity * @elem_size is a multiple of the
+    page size.
+ */
+extern ringbuffer_t* rbuf_new_mirrored(size_t capacity, size_t elem_size, int policy);
+
 /*  Push @data (with length @len) to @rb. -1 returned if failed.
+    When full, refer to @rb->policy: overwrite the oldest one, fail, or wait.
  */
 extern int rbuf_push_back(ringbuffer_t *rb, void *data, size_t len);
 
+/*  Same as #rbuf_push_back, but for a RBUF_OVERFLOW_BLOCK @rb wait at most
+    @timeout_ms milliseconds (< 0 - forever) for room. -1 returned if failed or timeout.
+ */
+extern int rbuf_push_back_timed(ringbuffer_t *rb, const void *data, size_t len, int timeout_ms);
+
 /*  popleft value to @pop_value (buffer with length @len which equals to @rb->block_size).
     nullptr returned if @rb is empty.
  */
 extern void *rbuf_pop_front(ringbuffer_t *rb, void *pop_value, size_t len);
 
+/*  Same as #rbuf_pop_front, but for a RBUF_OVERFLOW_BLOCK @rb wait at most
+    @timeout_ms milliseconds (< 0 - forever) for data. nullptr returned if failed or timeout.
+ */
+extern void *rbuf_pop_front_timed(ringbuffer_t *rb, void *pop_value, size_t len, int timeout_ms);
+
+/*  Push @n elements (@n * @len bytes, @len equals to @rb->block_size) from @data to @rb,
+    with at most two memcpy around the wrap point.
+    If @overwrite is TRUE, behave like @n times #rbuf_push_back: the oldest elements
+    are overwritten when full (only the last @capacity ones remain if @n > capacity),
+    and @n is returned. If FALSE, or @rb->policy is not RBUF_OVERFLOW_OVERWRITE, only
+    the free room is filled.
+    Return how many elements of @data were pushed, 0 if failed.
+ */
+extern size_t rbuf_push_back_n(ringbuffer_t *rb, const void *data, size_t n, size_t len,
+                               int overwrite);
+
+/*  popleft at most @n elements to @pop_values (buffer with length @n * @len, @len
+    equals to @rb->block_size), with at most two memcpy around the wrap point.
+    Return how many elements were popped, 0 if failed or @rb is empty.
+ */
+extern size_t rbuf_pop_front_n(ringbuffer_t *rb, void *pop_values, size_t n, size_t len);
+
+/*  Same as #rbuf_pop_front_n, but for a RBUF_OVERFLOW_BLOCK @rb wait at most
+    @timeout_ms milliseconds (< 0 - forever) until there are at least
+    #rbuf_set_wakeup_batch elements; after a timeout, pop whatever is there.
+ */
+extern size_t rbuf_pop_front_n_timed(ringbuffer_t *rb, void *pop_values, size_t n, size_t len,
+                                     int timeout_ms);
+
+/*  Batched wakeups of a RBUF_OVERFLOW_BLOCK @rb: sleeping consumers (and the
+    eventfd) are only notified once at least @batch elements are available (1 by
+    default). With @batch > 1, consumers should wait with a finite timeout so that
+    a short tail is not left behind. -1 returned if failed.
+ */
+extern int rbuf_set_wakeup_batch(ringbuffer_t *rb, size_t batch);
+
+/*  eventfd of a RBUF_OVERFLOW_BLOCK @rb (created on first call, linux only), so
+    that consumers can wait in epoll together with other fds. It becomes readable
+    when the wakeup batch is reached, and again after a pop leaving at least a batch
+    behind; read it (8 bytes) before draining @rb.
+    -1 returned if failed or not supported.
+ */
+extern int rbuf_eventfd(ringbuffer_t *rb);
+
+/*  A contiguous run of elements inside @rb->buffer, refer to #rbuf_reserve_back and
+    #rbuf_peek_front. When the run wraps, the second region is used as well.
+ */
+struct rbuf_region {
+    void *data;
+    size_t count;   // number of elements, not bytes.
+};
+
+/*  Zero-copy push: describe at most @n free elements at the back of @rb by one or
+    two @regions (@regions[1].count is 0 if not wrapped), so that the producer can
+    build them in place, then make them visible with #rbuf_commit_back.
+    Never overwrites. Return how many elements were reserved, 0 if failed or full.
+ */
+extern size_t rbuf_reserve_back(ringbuffer_t *rb, size_t n, struct rbuf_region regions[2]);
+
+/*  Append @n elements written in place (@n <= reserved). -1 returned if failed. */
+extern int rbuf_commit_back(ringbuffer_t *rb, size_t n);
+
+/*  Zero-copy pop: describe at most @n elements at the front of @rb by one or two
+    @regions, so that the consumer can process them in place, then release them
+    with #rbuf_consume_front. Return how many elements are described, 0 if empty.
+ */
+extern size_t rbuf_peek_front(ringbuffer_t *rb, size_t n, struct rbuf_region regions[2]);
+
+/*  Drop @n elements from the front (@n <= rbuf_length). -1 returned if failed. */
+extern int rbuf_consume_front(ringbuffer_t *rb, size_t n);
+
+#define RBUF_FD_READING 0x01
+#define RBUF_FD_WRITING 0x02
+
+/*  Fill the free room of @rb straight from @fd with a single readv() of the one or
+    two regions around the wrap point. Never overwrites. A trailing partial element
+    is kept in @rb->partial_in and completed by the next call.
+    Return the bytes read, 0 on end of file, -1 if failed (errno set, ENOBUFS if
+    @rb is full, EBUSY if another #rbuf_read_fd is running).
+    
+    The lock of a RBUF_OVERFLOW_BLOCK @rb is released during the syscall, so that
+    consumers are not blocked by a quiet @fd. Meanwhile, and while a partial element
+    is pending, the other push/reserve functions fail: #rbuf_read_fd should be the
+    only producer.
+ */
+extern ssize_t rbuf_read_fd(ringbuffer_t *rb, int fd);
+
+/*  Drain @rb straight to @fd with a single writev() of the one or two occupied
+    regions. Fully written elements are removed, a partially written one stays
+    at the front (refer to @rb->partial_out) and is completed by the next call.
+    Return the bytes written, 0 if @rb is empty, -1 if failed (errno set, EBUSY if
+    another #rbuf_write_fd is running).
+    
+    Same as #rbuf_read_fd, the lock is released during the syscall, and the other
+    pop/peek functions (and overwriting pushes) fail meanwhile and while a partial
+    element is pending: #rbuf_write_fd should be the only consumer.
+ */
+extern ssize_t rbuf_write_fd(ringbuffer_t *rb, int fd);
+
 /* -1 returned if failed. */
 extern int rbuf_destroy(ringbuffer_t *rb);
 
@@ -0,0 +1,204 @@
+// 2026-10-19 - SPSC ringbuffer living in a shared memory segment, for two processes.
+
+#define _GNU_SOURCE // memfd_create
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "shm_ringbuffer.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+/* map the whole segment of @fd and build the local handle, nullptr if failed. */
+static shm_ringbuffer_t *shm_rbuf_map_(int fd, size_t segment_size)
+{
+    shm_ringbuffer_t *rb = (shm_ringbuffer_t *) osal_mem_alloc(sizeof(shm_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    void *addr = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        osal_mem_free(rb);
+        return nullptr;
+    }
+    
+    rb->header = (struct shm_rbuf_header *) addr;
+    rb->segment_size = segment_size;
+    rb->fd = fd;
+    return rb;
+}
+
+/* complete the local handle from the validated geometry, not from the header again. */
+static void shm_rbuf_setup_(shm_ringbuffer_t *rb, size_t capacity, size_t block_size,
+                            size_t data_offset)
+{
+    struct shm_rbuf_header *header = rb->header;
+    rb->buffer = (char *) header + data_offset;
+    rb->mask = capacity - 1;
+    rb->block_size = block_size;
+    rb->cached_head = osal_atomic_load_acquire(&header->tail);
+    rb->cached_tail = osal_atomic_load_acquire(&header->head);
+}
+
+shm_ringbuffer_t* shm_rbuf_create(const char *name, size_t capacity, size_t elem_size)
+{
+    if (capacity == 0 || elem_size == 0)
+        return nullptr;
+    
+    size_t pow2 = 1;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    
+    size_t data_offset = sizeof(struct shm_rbuf_header);
+    size_t segment_size = data_offset + pow2 * elem_size;
+    
+    int fd;
+    if (name)
+        fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    else
+        fd = memfd_create("sakuc_shm_rbuf", 0);
+    if (fd < 0)
+        return nullptr;
+    
+    // ftruncate() zero fills, @ready is 0 until the header is complete.
+    shm_ringbuffer_t *rb = nullptr;
+    if (ftruncate(fd, (off_t) segment_size) != 0
+        || !(rb = shm_rbuf_map_(fd, segment_size))) {
+        close(fd);
+        if (name)
+            shm_unlink(name);
+        return nullptr;
+    }
+    
+    struct shm_rbuf_header *header = rb->header;
+    header->magic = SHM_RBUF_MAGIC;
+    header->version = SHM_RBUF_VERSION;
+    header->capacity = pow2;
+    header->block_size = elem_size;
+    header->data_offset = data_offset;
+    header->segment_size = segment_size;
+    header->head = header->tail = 0;
+    osal_atomic_store_release(&header->ready, 1);
+    
+    shm_rbuf_setup_(rb, pow2, elem_size, data_offset);
+    return rb;
+}
+
+shm_ringbuffer_t* shm_rbuf_attach_fd(int fd)
+{
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(struct shm_rbuf_header))
+        return nullptr;
+    
+    size_t segment_size = (size_t) st.st_size;
+    shm_ringbuffer_t *rb = shm_rbuf_map_(fd, segment_size);
+    if (!rb)
+        return nullptr;
+    
+    // @ready first (acquire), then everything written before it is visible. Each
+    // field is read once: the peer may change the header while we validate it.
+    struct shm_rbuf_header *header = rb->header;
+    int ready = osal_atomic_load_acquire(&header->ready) == 1;
+    uint32_t magic = osal_atomic_load_relaxed(&header->magic);
+    uint32_t version = osal_atomic_load_relaxed(&header->version);
+    size_t capacity = osal_atomic_load_relaxed(&header->capacity);
+    size_t block_size = osal_atomic_load_relaxed(&header->block_size);
+    size_t data_offset = osal_atomic_load_relaxed(&header->data_offset);
+    size_t header_segment_size = osal_atomic_load_relaxed(&header->segment_size);
+    
+    if (!ready || magic != SHM_RBUF_MAGIC || version != SHM_RBUF_VERSION
+        || header_segment_size != segment_size
+        || capacity == 0 || (capacity & (capacity - 1)) != 0
+        || block_size == 0
+        || data_offset < sizeof(struct shm_rbuf_header)
+        || data_offset > segment_size
+        || (segment_size - data_offset) / block_size < capacity) {
+        munmap(rb->header, segment_size);
+        osal_mem_free(rb);
+        return nullptr;
+    }
+    
+    shm_rbuf_setup_(rb, capacity, block_size, data_offset);
+    return rb;
+}
+
+shm_ringbuffer_t* shm_rbuf_attach(const char *name)
+{
+    if (!name)
+        return nullptr;
+    
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        return nullptr;
+    
+    shm_ringbuffer_t *rb = shm_rbuf_attach_fd(fd);
+    if (!rb)
+        close(fd);
+    return rb;
+}
+
+int shm_rbuf_push_back(shm_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || !data || len != rb->block_size)
+        return -1;
+    
+    struct shm_rbuf_header *header = rb->header;
+    size_t head = header->head; // only the producer writes it.
+    
+    // refresh the cached consumer's index only when we seem to be full.
+    if (head - rb->cached_head > rb->mask) {
+        rb->cached_head = osal_atomic_load_acquire(&header->tail);
+        if (head - rb->cached_head > rb->mask)
+            return -1;
+    }
+    
+    osal_memcpy((char *)rb->buffer + (head & rb->mask) * len, data, len);
+    osal_atomic_store_release(&header->head, head + 1);
+    return 0;
+}
+
+void *shm_rbuf_pop_front(shm_ringbuffer_t *rb, void *pop_value, size_t len)
+{
+    if (!rb || !pop_value || len != rb->block_size)
+        return nullptr;
+    
+    struct shm_rbuf_header *header = rb->header;
+    size_t tail = header->tail; // only the consumer writes it.
+    
+    // refresh the cached producer's index only when we seem to be empty.
+    if (tail == rb->cached_tail) {
+        rb->cached_tail = osal_atomic_load_acquire(&header->head);
+        if (tail == rb->cached_tail)
+            return nullptr;
+    }
+    
+    osal_memcpy(pop_value, (char *)rb->buffer + (tail & rb->mask) * len, len);
+    osal_atomic_store_release(&header->tail, tail + 1);
+    return pop_value;
+}
+
+size_t shm_rbuf_length(shm_ringbuffer_t *rb)
+{
+    size_t tail = osal_atomic_load_acquire(&rb->header->tail);
+    size_t head = osal_atomic_load_acquire(&rb->header->head);
+    return head - tail;
+}
+
+int shm_rbuf_detach(shm_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->header))
+        return -1;
+    
+    munmap(rb->header, rb->segment_size);
+    close(rb->fd);
+    osal_mem_free(rb);
+    return 0;
+}
+
+int shm_rbuf_unlink(const char *name)
+{
+    if (!name)
+        return -1;
+    return shm_unlink(name) == 0 ? 0 : -1;
+}
@@ -0,0 +1,80 @@
+// 2026-10-19 - SPSC ringbuffer living in a shared memory segment, for two processes.
+
+#ifndef SAKUC_SHM_RINGBUFFER_H_
+#define SAKUC_SHM_RINGBUFFER_H_
+
+#include <stdint.h>
+#include "common_defs.h"
+
+#define SHM_RBUF_MAGIC      0x73726266u     // "srbf"
+#define SHM_RBUF_VERSION    1u
+
+/*  Header placed at offset 0 of the segment. It holds no pointer (each process
+    maps the segment at its own address), the slots start at @data_offset bytes
+    from the header. Only types with the same layout in both processes are used.
+ */
+struct shm_rbuf_header {
+    uint32_t magic;         // SHM_RBUF_MAGIC.
+    uint32_t version;       // SHM_RBUF_VERSION.
+    uint32_t ready;         // set (release) by the creator when the header is complete.
+    uint32_t reserved;
+    size_t capacity;        // power of 2.
+    size_t block_size;
+    size_t data_offset;     // from the beginning of the header.
+    size_t segment_size;    // whole segment, header included.
+    char pad0[SAKUC_CACHE_LINE_SIZE - 4 * sizeof(uint32_t) - 4 * sizeof(size_t)];
+    
+    size_t head;            // free-running, written by the producer.
+    char pad1[SAKUC_CACHE_LINE_SIZE - sizeof(size_t)];
+    size_t tail;            // free-running, written by the consumer.
+    char pad2[SAKUC_CACHE_LINE_SIZE - sizeof(size_t)];
+};
+
+/* Process local handle of a mapped segment. */
+typedef struct shm_ringbuffer {
+    struct shm_rbuf_header *header;  // the mapping.
+    void *buffer;       // header + data_offset, in this process.
+    size_t mask;        // capacity - 1.
+    size_t block_size;
+    size_t cached_head; // producer's view of tail / consumer's view of head, private.
+    size_t cached_tail;
+    size_t segment_size; // of the mapping, the header is not trusted after attaching.
+    int fd;
+} shm_ringbuffer_t;
+
+/*  Create the segment @name (see shm_open(3), e.g. "/capture") and initialize a
+    ringbuffer of @capacity (rounded up to power of 2) elements of @elem_size bytes.
+    If @name is nullptr, an anonymous memfd is used instead, to be shared through
+    fork() or fd passing, refer to #shm_rbuf_fd and #shm_rbuf_attach_fd.
+    nullptr returned if failed (e.g. @name already exists).
+ */
+extern shm_ringbuffer_t* shm_rbuf_create(const char *name, size_t capacity, size_t elem_size);
+
+/*  Attach to a segment created by #shm_rbuf_create. The segment size, magic,
+    version and geometry are validated before use, and nullptr is returned if the
+    creator has not finished initializing it yet (retry later) or it is not valid.
+    The geometry is read from the header only once: the peer changing it later
+    cannot redirect this handle.
+ */
+extern shm_ringbuffer_t* shm_rbuf_attach(const char *name);
+extern shm_ringbuffer_t* shm_rbuf_attach_fd(int fd);
+
+/*  Only one process may push and only one (other) process may pop, refer to
+    #spsc_rbuf_push_back and #spsc_rbuf_pop_front. No syscall is involved.
+ */
+extern int shm_rbuf_push_back(shm_ringbuffer_t *rb, const void *data, size_t len);
+extern void *shm_rbuf_pop_front(shm_ringbuffer_t *rb, void *pop_value, size_t len);
+
+/* approximate when used concurrently. */
+extern size_t shm_rbuf_length(shm_ringbuffer_t *rb);
+
+/* file descriptor of the segment, valid until #shm_rbuf_detach. */
+#define shm_rbuf_fd(rb) ((rb)->fd)
+
+/* Unmap the segment in this process. -1 returned if failed. */
+extern int shm_rbuf_detach(shm_ringbuffer_t *rb);
+
+/* Remove the segment @name, the mappings stay valid until detached. -1 returned if failed. */
+extern int shm_rbuf_unlink(const char *name);
+
+#endif // SAKUC_SHM_RINGBUFFER_H_
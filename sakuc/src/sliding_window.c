@@ -0,0 +1,202 @@
+// 2026-10-19 - sliding-window min / max of a stream, by monotonic deques.
+
+#include "sliding_window.h"
+#include "common_memory_management_defs.h"
+
+// entries per deque block (4KB), and samples per chunk of #swin_push_n.
+#define SWIN_BLOCK_SIZE 256
+#define SWIN_BATCH_SIZE 256
+
+/* the new @value makes the candidate @old useless: never the min (max) any more. */
+#define swin_dominates_(is_max, value, old) ((is_max) ? (value) >= (old) : (value) <= (old))
+
+sliding_window_t *swin_new(const size_t *lengths, size_t num_windows)
+{
+    if (!lengths || num_windows == 0)
+        return nullptr;
+
+    sliding_window_t *sw = (sliding_window_t *) osal_mem_calloc(1,
+        sizeof(sliding_window_t) + num_windows * sizeof(struct swin_window_));
+    if (!sw)
+        return nullptr;
+
+    sw->num_windows = num_windows;
+    for (size_t i = 0; i < num_windows; i++) {
+        if (lengths[i] == 0) {
+            osal_mem_free(sw);
+            return nullptr;
+        }
+        sw->windows[i].length = lengths[i];
+        if (lengths[i] > sw->longest)
+            sw->longest = lengths[i];
+    }
+
+    sw->pool = sakuc_deque_pool_new(SWIN_BLOCK_SIZE, sizeof(struct swin_entry_), 2, 8);
+    if (sw->pool) {
+        sw->min_dq = sakuc_deque_new_with_pool(SWIN_BLOCK_SIZE, sizeof(struct swin_entry_),
+                                               SAKUC_DEQUE_SWEEP_IMMEDIATELY, sw->pool);
+        sw->max_dq = sakuc_deque_new_with_pool(SWIN_BLOCK_SIZE, sizeof(struct swin_entry_),
+                                               SAKUC_DEQUE_SWEEP_IMMEDIATELY, sw->pool);
+    }
+    if (!sw->pool || !sw->min_dq || !sw->max_dq) {
+        swin_destroy(sw);
+        return nullptr;
+    }
+    return sw;
+}
+
+/*  push the sample (@seq, @value) to the candidates of @dq (@is_max - the max ones),
+    whose front one has the id @popped, and the front / back ones are copied in @ends.
+    -1 returned if failed.
+ */
+static int swin_candidate_push_(sliding_window_t *sw, sakuc_deque_t *dq, uint64_t popped,
+                                struct swin_entry_ *ends, int is_max, uint64_t seq, double value)
+{
+    struct swin_entry_ entry;
+    size_t length = sakuc_deque_size(dq), before = length;
+    while (length > 0 && swin_dominates_(is_max, value, ends[1].value)) {
+        sakuc_deque_pop_back(dq, &entry, sizeof(entry));
+        if (-- length > 0)
+            ends[1] = *(struct swin_entry_ *) sakuc_deque_peek_back(dq);
+    }
+
+    // cursors on the popped ones move to the new one, the first within their window now.
+    if (length < before) {
+        uint64_t id = popped + length;
+        for (size_t i = 0; i < sw->num_windows; i++) {
+            uint64_t *cursor = is_max ? &sw->windows[i].max_id : &sw->windows[i].min_id;
+            if (*cursor > id)
+                *cursor = id;
+        }
+    }
+
+    entry.seq = seq;
+    entry.value = value;
+    if (sakuc_deque_push_back(dq, &entry, sizeof(entry)) == -1)
+        return -1;
+    if (length == 0)
+        ends[0] = entry;
+    ends[1] = entry;
+    return 0;
+}
+
+/* pop the candidates out of the longest window. */
+static void swin_expire_(sliding_window_t *sw, sakuc_deque_t *dq, uint64_t *popped,
+                         struct swin_entry_ *ends)
+{
+    struct swin_entry_ entry;
+    uint64_t start = sw->count > sw->longest ? sw->count - sw->longest : 0;
+    while (sakuc_deque_size(dq) > 0 && ends[0].seq < start) {
+        sakuc_deque_pop_front(dq, &entry, sizeof(entry));
+        ++ *popped;
+        if (sakuc_deque_size(dq) > 0)
+            ends[0] = *(struct swin_entry_ *) sakuc_deque_peek_front(dq);
+    }
+}
+
+int swin_push(sliding_window_t *sw, double value)
+{
+    if (!sw)
+        return -1;
+
+    if (swin_candidate_push_(sw, sw->min_dq, sw->min_popped, sw->min_ends, FALSE, sw->count, value) == -1
+        || swin_candidate_push_(sw, sw->max_dq, sw->max_popped, sw->max_ends, TRUE, sw->count, value) == -1)
+        return -1;
+    ++ sw->count;
+    swin_expire_(sw, sw->min_dq, &sw->min_popped, sw->min_ends);
+    swin_expire_(sw, sw->max_dq, &sw->max_popped, sw->max_ends);
+    return 0;
+}
+
+int swin_push_n(sliding_window_t *sw, const double *values, size_t n)
+{
+    if (!sw || (!values && n > 0))
+        return -1;
+
+    // the samples before the last @longest ones would be out of every window.
+    if (n > sw->longest) {
+        sw->count += n - sw->longest;
+        values += n - sw->longest;
+        n = sw->longest;
+    }
+
+    uint16_t min_idx[SWIN_BATCH_SIZE], max_idx[SWIN_BATCH_SIZE];
+    while (n > 0) {
+        size_t m = n < SWIN_BATCH_SIZE ? n : SWIN_BATCH_SIZE;
+
+        // from the last one backwards: the candidates are the ones beating every later one.
+        size_t num_min = 0, num_max = 0;
+        for (size_t i = m; i-- > 0; ) {
+            if (num_min == 0 || values[i] < values[min_idx[num_min - 1]])
+                min_idx[num_min ++] = (uint16_t) i;
+            if (num_max == 0 || values[i] > values[max_idx[num_max - 1]])
+                max_idx[num_max ++] = (uint16_t) i;
+        }
+        while (num_min > 0) {
+            size_t i = min_idx[-- num_min];
+            if (swin_candidate_push_(sw, sw->min_dq, sw->min_popped, sw->min_ends, FALSE, sw->count + i,
+                                     values[i]) == -1)
+                return -1;
+        }
+        while (num_max > 0) {
+            size_t i = max_idx[-- num_max];
+            if (swin_candidate_push_(sw, sw->max_dq, sw->max_popped, sw->max_ends, TRUE, sw->count + i,
+                                     values[i]) == -1)
+                return -1;
+        }
+
+        sw->count += m;
+        swin_expire_(sw, sw->min_dq, &sw->min_popped, sw->min_ends);
+        swin_expire_(sw, sw->max_dq, &sw->max_popped, sw->max_ends);
+        values += m;
+        n -= m;
+    }
+    return 0;
+}
+
+/* the first candidate of @dq within the window, from the @cursor on. */
+static int swin_query_(sliding_window_t *sw, sakuc_deque_t *dq, uint64_t popped,
+                       size_t window, uint64_t *cursor, double *result)
+{
+    uint64_t start = sw->count > sw->windows[window].length
+                     ? sw->count - sw->windows[window].length : 0;
+    uint64_t id = *cursor > popped ? *cursor : popped;
+
+    // the last sample is a candidate, and within any window.
+    struct swin_entry_ *entry;
+    while ((entry = (struct swin_entry_ *) sakuc_deque_at(dq, (size_t) (id - popped)))->seq < start)
+        ++ id;
+    *cursor = id;
+    *result = entry->value;
+    return 0;
+}
+
+int swin_min(sliding_window_t *sw, size_t window, double *min)
+{
+    if (!sw || !min || window >= sw->num_windows || sw->count == 0)
+        return -1;
+    return swin_query_(sw, sw->min_dq, sw->min_popped, window, &sw->windows[window].min_id, min);
+}
+
+int swin_max(sliding_window_t *sw, size_t window, double *max)
+{
+    if (!sw || !max || window >= sw->num_windows || sw->count == 0)
+        return -1;
+    return swin_query_(sw, sw->max_dq, sw->max_popped, window, &sw->windows[window].max_id, max);
+}
+
+int swin_destroy(sliding_window_t *sw)
+{
+    if (!sw)
+        return -1;
+
+    // the deques first, their blocks go back to the pool.
+    if (sw->min_dq)
+        sakuc_deque_destroy(sw->min_dq);
+    if (sw->max_dq)
+        sakuc_deque_destroy(sw->max_dq);
+    if (sw->pool)
+        sakuc_deque_pool_destroy(sw->pool);
+    osal_mem_free(sw);
+    return 0;
+}
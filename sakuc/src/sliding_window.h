@@ -0,0 +1,82 @@
+// 2026-10-19 - sliding-window min / max of a stream, by monotonic deques.
+
+#ifndef SAKUC_SLIDING_WINDOW_H_
+#define SAKUC_SLIDING_WINDOW_H_
+
+#include <stdint.h>
+#include "common_defs.h"
+#include "deque.h"
+
+/*  Min / max over the last @length samples of a stream, for any number of windows
+    (of different lengths) sharing it, amortized O(1) per sample and per query.
+
+    @min_dq holds the candidates of the longest window: the samples smaller than
+    every later one, so their values increase from front to back. A new sample pops
+    the back ones not smaller than itself, then is pushed; the front one expires
+    once it is out of the longest window. The minimum of the longest window is the
+    front one, and that of a shorter window is the first one within it - a
+    candidate for the longest window is one for every window, as it depends on the
+    later samples only. @max_dq is the same with the values decreasing.
+
+    So a window keeps only a cursor into each deque, moving towards the back as
+    the window slides (and moved back to the new sample if the candidate it was on
+    has been popped), and the deques are shared by all the windows.
+
+    Values must not be NaN.
+
+    eg. size_t lengths[] = { 60, 3600 };
+        sliding_window_t *sw = swin_new(lengths, 2);
+        swin_push(sw, value);
+        swin_min(sw, 1, &min);      // min of the last 3600 samples.
+ */
+struct swin_entry_ {
+    uint64_t seq;       // 0 - the first sample of the stream.
+    double value;
+};
+
+struct swin_window_ {
+    size_t length;
+    uint64_t min_id;    // cursors, ids of the candidates (id of the front one: @*_popped).
+    uint64_t max_id;
+};
+
+typedef struct sliding_window {
+    sakuc_deque_t *min_dq;      // struct swin_entry_.
+    sakuc_deque_t *max_dq;
+    sakuc_deque_pool_t *pool;   // blocks of both deques.
+    uint64_t min_popped;        // popped from the front so far.
+    uint64_t max_popped;
+    struct swin_entry_ min_ends[2]; // copies of the front and back candidates, if any.
+    struct swin_entry_ max_ends[2];
+    uint64_t count;             // samples pushed so far.
+    size_t longest;
+    size_t num_windows;
+    struct swin_window_ windows[];
+} sliding_window_t;
+
+/*  New the windows over the last @lengths[0] ~ @lengths[num_windows - 1] samples
+    (each at least 1) of one stream. nullptr returned if failed.
+ */
+extern sliding_window_t *swin_new(const size_t *lengths, size_t num_windows);
+
+/* Push the next sample of the stream. -1 returned if failed to allocate memory. */
+extern int swin_push(sliding_window_t *sw, double value);
+
+/*  Push the next @n samples, same as @n #swin_push but faster: only the samples
+    smaller (greater) than every later one of @values become candidates, and only
+    the last @longest samples are looked at. -1 returned if failed.
+ */
+extern int swin_push_n(sliding_window_t *sw, const double *values, size_t n);
+
+/*  Min / max of the window @window (index within the @lengths given to #swin_new),
+    over fewer samples until @length ones have been pushed.
+    -1 returned if no sample yet or @window is out of range.
+ */
+extern int swin_min(sliding_window_t *sw, size_t window, double *min);
+extern int swin_max(sliding_window_t *sw, size_t window, double *max);
+
+extern int swin_destroy(sliding_window_t *sw);
+
+#define swin_count(sw) ((sw)->count)
+
+#endif // SAKUC_SLIDING_WINDOW_H_
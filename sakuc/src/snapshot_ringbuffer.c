@@ -0,0 +1,128 @@
+// 2026-10-19 - overwrite-mode ringbuffer (flight recorder) with lock-free snapshot reads.
+
+#include "snapshot_ringbuffer.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+#define snap_slot_(rb, seq) ((char *)(rb)->buffer + ((seq) & (rb)->mask) * (rb)->slot_size)
+#define snap_stamp_(slot) ((size_t *)(slot))
+#define snap_data_(slot) ((char *)(slot) + sizeof(size_t))
+
+snapshot_ringbuffer_t* snap_rbuf_new(size_t capacity, size_t elem_size)
+{
+    if (capacity == 0 || elem_size == 0)
+        return nullptr;
+    
+    size_t pow2 = 1;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    size_t slot_size = (sizeof(size_t) + elem_size + sizeof(size_t) - 1)
+                       / sizeof(size_t) * sizeof(size_t);
+    
+    snapshot_ringbuffer_t *rb = (snapshot_ringbuffer_t *)
+        osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, sizeof(snapshot_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    rb->buffer = osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, pow2 * slot_size);
+    if (!rb->buffer) {
+        osal_mem_aligned_free(rb);
+        return nullptr;
+    }
+    
+    rb->capacity = pow2; rb->mask = pow2 - 1;
+    rb->block_size = elem_size;
+    rb->slot_size = slot_size;
+    rb->head = 0;
+    for (size_t i=0; i < pow2; i++)
+        *snap_stamp_(snap_slot_(rb, i)) = 0;
+    
+    return rb;
+}
+
+int snap_rbuf_push_back(snapshot_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || !data || len != rb->block_size)
+        return -1;
+    
+    size_t head = rb->head; // only the producer writes it.
+    char *slot = snap_slot_(rb, head);
+    
+    osal_atomic_store_relaxed(snap_stamp_(slot), 0);
+    osal_atomic_fence_release();
+    osal_memcpy(snap_data_(slot), data, len);
+    osal_atomic_store_release(snap_stamp_(slot), head + 1);
+    osal_atomic_store_release(&rb->head, head + 1);
+    return 0;
+}
+
+/* copy element @seq to @dst. -1 returned if the slot no longer (or not yet) holds it. */
+static int snap_rbuf_read_(snapshot_ringbuffer_t *rb, size_t seq, void *dst)
+{
+    char *slot = snap_slot_(rb, seq);
+    if (osal_atomic_load_acquire(snap_stamp_(slot)) != seq + 1)
+        return -1;
+    
+    osal_memcpy(dst, snap_data_(slot), rb->block_size);
+    osal_atomic_fence_acquire();
+    return osal_atomic_load_relaxed(snap_stamp_(slot)) == seq + 1 ? 0 : -1;
+}
+
+size_t snap_rbuf_snapshot(snapshot_ringbuffer_t *rb, void *dst, size_t k, size_t len,
+                          size_t *first_seq)
+{
+    if (first_seq)
+        *first_seq = 0;
+    if (!rb || !dst || len != rb->block_size)
+        return 0;
+    
+    char *out = (char *) dst;
+    size_t valid = 0;   // newest elements copied, at the end of the @k slots of @out.
+    size_t head = 0;
+    
+    for (int attempt=0; attempt <= SNAP_RBUF_MAX_RETRIES; attempt++) {
+        head = osal_atomic_load_acquire(&rb->head);
+        size_t n = k;
+        if (n > head)
+            n = head;
+        if (n > rb->capacity)
+            n = rb->capacity;
+        
+        // newest first: once a slot is overwritten, all the older ones are gone too.
+        valid = 0;
+        while (valid < n
+               && snap_rbuf_read_(rb, head - 1 - valid, out + (n - 1 - valid) * len) == 0)
+            ++ valid;
+        
+        if (valid == n) {
+            if (first_seq)
+                *first_seq = head - n;
+            return n;
+        }
+        if (attempt == SNAP_RBUF_MAX_RETRIES) {
+            // keep the newest consistent run, oldest first at @dst.
+            memmove(out, out + (n - valid) * len, valid * len);
+            break;
+        }
+    }
+    
+    if (first_seq)
+        *first_seq = head - valid;
+    return valid;
+}
+
+size_t snap_rbuf_length(snapshot_ringbuffer_t *rb)
+{
+    size_t head = osal_atomic_load_acquire(&rb->head);
+    return head > rb->capacity ? rb->capacity : head;
+}
+
+int snap_rbuf_destroy(snapshot_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->buffer))
+        return -1;
+    
+    osal_mem_aligned_free(rb->buffer);
+    osal_mem_aligned_free(rb);
+    return 0;
+}
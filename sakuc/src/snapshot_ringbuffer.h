@@ -0,0 +1,61 @@
+// 2026-10-19 - overwrite-mode ringbuffer (flight recorder) with lock-free snapshot reads.
+
+#ifndef SAKUC_SNAPSHOT_RINGBUFFER_H_
+#define SAKUC_SNAPSHOT_RINGBUFFER_H_
+
+#include "common_defs.h"
+
+/*  Like #rbuf_push_back of a RBUF_OVERFLOW_OVERWRITE ringbuffer, the last @capacity
+    elements are kept. The producer never waits; any number of monitoring threads
+    may copy the most recent elements meanwhile, refer to #snap_rbuf_snapshot.
+    
+    Every slot holds a @stamp followed by @block_size bytes of data (seqlock):
+    stamp == seq + 1         - slot holds element @seq (free-running sequence).
+    stamp == 0               - slot is being overwritten by the producer.
+ */
+typedef struct snapshot_ringbuffer {
+    // read-only after #snap_rbuf_new.
+    size_t capacity;    // power of 2.
+    size_t mask;        // capacity - 1.
+    size_t block_size;
+    size_t slot_size;   // sizeof(size_t) + block_size, rounded up to sizeof(size_t).
+    void *buffer;
+    char pad[SAKUC_CACHE_LINE_SIZE - 4 * sizeof(size_t) - sizeof(void *)];
+    
+    size_t head;        // next sequence to be written, written by the producer.
+} snapshot_ringbuffer_t;
+
+/* Retries of #snap_rbuf_snapshot when the producer overtakes the copy. */
+#ifndef SNAP_RBUF_MAX_RETRIES
+#define SNAP_RBUF_MAX_RETRIES 4
+#endif
+
+/*  New a snapshot ringbuffer, @capacity is rounded up to power of 2.
+    nullptr returned if failed to allocate memory.
+ */
+extern snapshot_ringbuffer_t* snap_rbuf_new(size_t capacity, size_t elem_size);
+
+/*  Push @data (with length @len) to @rb, overwriting the oldest element when full.
+    Single producer thread only. -1 returned if failed.
+ */
+extern int snap_rbuf_push_back(snapshot_ringbuffer_t *rb, const void *data, size_t len);
+
+/*  Copy the most recent (at most) @k elements to @dst (buffer with length @k * @len,
+    @len equals to @rb->block_size), oldest first, without stopping the producer.
+    Every element is validated by its stamp: torn or overwritten slots are never
+    returned. If the producer overtakes the copy, it is retried (at most
+    SNAP_RBUF_MAX_RETRIES times), then only the newest consistent elements are kept.
+    @first_seq - optional, set to the sequence of @dst[0], so that gaps between
+    two snapshots can be detected.
+    Return how many consecutive elements were copied.
+ */
+extern size_t snap_rbuf_snapshot(snapshot_ringbuffer_t *rb, void *dst, size_t k, size_t len,
+                                 size_t *first_seq);
+
+/* elements currently kept, approximate when used concurrently. */
+extern size_t snap_rbuf_length(snapshot_ringbuffer_t *rb);
+
+/* -1 returned if failed. No thread may use @rb any more. */
+extern int snap_rbuf_destroy(snapshot_ringbuffer_t *rb);
+
+#endif // SAKUC_SNAPSHOT_RINGBUFFER_H_
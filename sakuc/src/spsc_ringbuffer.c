@@ -0,0 +1,88 @@
+// 2026-10-19 - single-producer/single-consumer lock-free variant of ringbuffer_t.
+
+#include "spsc_ringbuffer.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+spsc_ringbuffer_t* spsc_rbuf_new(size_t capacity, size_t elem_size)
+{
+    if (capacity == 0 || elem_size == 0)
+        return nullptr;
+    
+    size_t pow2 = 1;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    
+    spsc_ringbuffer_t *rb = (spsc_ringbuffer_t *)
+        osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, sizeof(spsc_ringbuffer_t));
+    if (!rb)
+        return nullptr;
+    
+    rb->buffer = osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE, pow2 * elem_size);
+    if (!rb->buffer) {
+        osal_mem_aligned_free(rb);
+        return nullptr;
+    }
+    
+    rb->capacity = pow2; rb->mask = pow2 - 1;
+    rb->block_size = elem_size;
+    rb->head.index = rb->head.cached = 0;
+    rb->tail.index = rb->tail.cached = 0;
+    
+    return rb;
+}
+
+int spsc_rbuf_push_back(spsc_ringbuffer_t *rb, const void *data, size_t len)
+{
+    if (!rb || !data || len != rb->block_size)
+        return -1;
+    
+    size_t head = rb->head.index; // only the producer writes it.
+    
+    // refresh the cached consumer's index only when we seem to be full.
+    if (head - rb->head.cached == rb->capacity) {
+        rb->head.cached = osal_atomic_load_acquire(&rb->tail.index);
+        if (head - rb->head.cached == rb->capacity)
+            return -1;
+    }
+    
+    osal_memcpy((char *)rb->buffer + (head & rb->mask) * len, data, len);
+    osal_atomic_store_release(&rb->head.index, head + 1);
+    return 0;
+}
+
+void *spsc_rbuf_pop_front(spsc_ringbuffer_t *rb, void *pop_value, size_t len)
+{
+    if (!rb || !pop_value || len != rb->block_size)
+        return nullptr;
+    
+    size_t tail = rb->tail.index; // only the consumer writes it.
+    
+    // refresh the cached producer's index only when we seem to be empty.
+    if (tail == rb->tail.cached) {
+        rb->tail.cached = osal_atomic_load_acquire(&rb->head.index);
+        if (tail == rb->tail.cached)
+            return nullptr;
+    }
+    
+    osal_memcpy(pop_value, (char *)rb->buffer + (tail & rb->mask) * len, len);
+    osal_atomic_store_release(&rb->tail.index, tail + 1);
+    return pop_value;
+}
+
+int spsc_rbuf_destroy(spsc_ringbuffer_t *rb)
+{
+    if (!rb || !(rb->buffer))
+        return -1;
+    
+    osal_mem_aligned_free(rb->buffer);
+    osal_mem_aligned_free(rb);
+    return 0;
+}
+
+size_t spsc_rbuf_length(spsc_ringbuffer_t *rb)
+{
+    size_t tail = osal_atomic_load_acquire(&rb->tail.index);
+    size_t head = osal_atomic_load_acquire(&rb->head.index);
+    return head - tail;
+}
@@ -0,0 +1,54 @@
+// 2026-10-19 - single-producer/single-consumer lock-free variant of ringbuffer_t.
+
+#ifndef SAKUC_SPSC_RINGBUFFER_H_
+#define SAKUC_SPSC_RINGBUFFER_H_
+
+#include "common_defs.h"
+
+/* Index owned (written) by one side and read by the other side, each of them
+   on its own cache line so that producer and consumer never false-share.
+ */
+struct spsc_rbuf_index_ {
+    size_t index;   // free-running counter, slot = (index & mask).
+    size_t cached;  // cached copy of the opposite side's @index, private.
+    char pad[SAKUC_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+};
+
+typedef struct spsc_ringbuffer {
+    // read-only after #spsc_rbuf_new, shared by both sides.
+    size_t capacity;    // power of 2.
+    size_t mask;        // capacity - 1.
+    size_t block_size;
+    void *buffer;
+    char pad[SAKUC_CACHE_LINE_SIZE - 3 * sizeof(size_t) - sizeof(void *)];
+
+    struct spsc_rbuf_index_ head;   // written by the producer (#spsc_rbuf_push_back).
+    struct spsc_rbuf_index_ tail;   // written by the consumer (#spsc_rbuf_pop_front).
+} spsc_ringbuffer_t;
+
+/*  New a SPSC ringbuffer (FIFO), @capacity is rounded up to power of 2.
+    nullptr returned if failed to allocate memory.
+    
+    Exactly one thread may push and exactly one (other) thread may pop, no lock
+    is required. Unlike #rbuf_push_back, a full buffer is never overwritten since
+    the slot might be being read by the consumer.
+ */
+extern spsc_ringbuffer_t* spsc_rbuf_new(size_t capacity, size_t elem_size);
+
+/*  Push @data (with length @len) to @rb, producer side only.
+    -1 returned if failed or @rb is full.
+ */
+extern int spsc_rbuf_push_back(spsc_ringbuffer_t *rb, const void *data, size_t len);
+
+/*  popleft value to @pop_value (buffer with length @len which equals to @rb->block_size),
+    consumer side only. nullptr returned if @rb is empty.
+ */
+extern void *spsc_rbuf_pop_front(spsc_ringbuffer_t *rb, void *pop_value, size_t len);
+
+/* -1 returned if failed. */
+extern int spsc_rbuf_destroy(spsc_ringbuffer_t *rb);
+
+/* approximate when used concurrently, exact on either side when the other side is idle. */
+extern size_t spsc_rbuf_length(spsc_ringbuffer_t *rb);
+
+#endif // SAKUC_SPSC_RINGBUFFER_H_
@@ -0,0 +1,165 @@
+// 2026-10-19 - hierarchical hashed timing wheel, O(1) schedule/cancel/tick.
+
+#include "timing_wheel.h"
+#include "common_memory_management_defs.h"
+
+#define tw_list_init_(head) do {                            \
+    (head)->prev = (head); (head)->next = (head);           \
+} while (__LINE__ == -1)
+
+#define tw_list_empty_(head) ((head)->next == (head))
+
+static void tw_list_add_tail_(struct tw_link *head, struct tw_link *link)
+{
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void tw_list_del_(struct tw_link *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = link->next = nullptr;
+}
+
+/* move all of @from to the (empty) @to, O(1). */
+static void tw_list_splice_(struct tw_link *from, struct tw_link *to)
+{
+    if (tw_list_empty_(from)) {
+        tw_list_init_(to);
+        return;
+    }
+    to->next = from->next; to->prev = from->prev;
+    to->next->prev = to; to->prev->next = to;
+    tw_list_init_(from);
+}
+
+timing_wheel_t* tw_new(uint64_t now)
+{
+    timing_wheel_t *tw = (timing_wheel_t *) osal_mem_alloc(sizeof(timing_wheel_t));
+    if (!tw)
+        return nullptr;
+    
+    tw->now = now;
+    tw->count = 0;
+    for (int level=0; level < TW_LEVELS; level++)
+        for (int i=0; i < TW_SLOTS; i++)
+            tw_list_init_(&tw->slots[level][i]);
+    
+    return tw;
+}
+
+void tw_timer_init(tw_timer_t *timer, tw_callback_t callback, void *arg)
+{
+    timer->link.prev = timer->link.next = nullptr;
+    timer->expires = 0;
+    timer->callback = callback;
+    timer->arg = arg;
+}
+
+/* link @timer to the slot of its @expires relative to @tw->now (@expires >= now). */
+static void tw_add_(timing_wheel_t *tw, tw_timer_t *timer)
+{
+    uint64_t expires = timer->expires;
+    uint64_t delta = expires - tw->now;
+    
+    int level = 0;
+    while (level < TW_LEVELS - 1 && delta >= ((uint64_t) 1 << ((level + 1) * TW_SLOT_BITS)))
+        ++ level;
+    
+    // too far for the top level, park it in its last slot (cascaded again later).
+    uint64_t range = (uint64_t) 1 << (TW_LEVELS * TW_SLOT_BITS);
+    if (delta >= range)
+        expires = tw->now + range - 1;
+    
+    size_t index = (expires >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK;
+    tw_list_add_tail_(&tw->slots[level][index], &timer->link);
+}
+
+int tw_schedule(timing_wheel_t *tw, tw_timer_t *timer, uint64_t delay)
+{
+    if (!tw || !timer)
+        return -1;
+    
+    if (tw_timer_pending(timer))
+        tw_list_del_(&timer->link);
+    else
+        ++ tw->count;
+    
+    timer->expires = tw->now + (delay > 0 ? delay : 1);
+    tw_add_(tw, timer);
+    return 0;
+}
+
+int tw_cancel(timing_wheel_t *tw, tw_timer_t *timer)
+{
+    if (!tw || !timer || !tw_timer_pending(timer))
+        return -1;
+    
+    tw_list_del_(&timer->link);
+    -- tw->count;
+    return 0;
+}
+
+/* re-add the timers of slot @index at @level, they land on lower levels. */
+static void tw_cascade_(timing_wheel_t *tw, int level, size_t index)
+{
+    struct tw_link list;
+    tw_list_splice_(&tw->slots[level][index], &list);
+    
+    while (!tw_list_empty_(&list)) {
+        tw_timer_t *timer = (tw_timer_t *) list.next;
+        tw_list_del_(&timer->link);
+        tw_add_(tw, timer);
+    }
+}
+
+size_t tw_advance(timing_wheel_t *tw, uint64_t ticks)
+{
+    if (!tw)
+        return 0;
+    
+    size_t expired = 0;
+    while (ticks-- > 0) {
+        if (tw->count == 0) {
+            // nothing can expire nor cascade, jump to the end.
+            tw->now += ticks + 1;
+            break;
+        }
+        
+        uint64_t now = ++ tw->now;
+        size_t index = now & TW_SLOT_MASK;
+        
+        // cascade level 1 when level 0 wraps, level 2 when level 1 wraps, etc.
+        for (int level=1; index == 0 && level < TW_LEVELS; level++) {
+            index = (now >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK;
+            tw_cascade_(tw, level, index);
+        }
+        
+        // detach the whole slot first, the callbacks may touch the wheel.
+        struct tw_link list;
+        tw_list_splice_(&tw->slots[0][now & TW_SLOT_MASK], &list);
+        
+        while (!tw_list_empty_(&list)) {
+            tw_timer_t *timer = (tw_timer_t *) list.next;
+            tw_list_del_(&timer->link);
+            -- tw->count;
+            ++ expired;
+            if (timer->callback)
+                timer->callback(timer, timer->arg);
+        }
+    }
+    
+    return expired;
+}
+
+int tw_destroy(timing_wheel_t *tw)
+{
+    if (!tw)
+        return -1;
+    
+    osal_mem_free(tw);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// 2026-10-19 - hierarchical hashed timing wheel, O(1) schedule/cancel/tick.
+
+#ifndef SAKUC_TIMING_WHEEL_H_
+#define SAKUC_TIMING_WHEEL_H_
+
+#include <stdint.h>
+#include "common_defs.h"
+
+/*  TW_LEVELS wheels of TW_SLOTS slots each. Like ringbuffer_t, the slots of a level
+    form a ring, indexed by (expiry tick >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK.
+    Level 0 holds the timers of the next TW_SLOTS ticks; a higher level is cascaded
+    down one level each time the level below wraps around. Timers further than
+    2^(TW_LEVELS * TW_SLOT_BITS) ticks stay in the last slot of the top level until
+    they come into range.
+ */
+#define TW_SLOT_BITS    8
+#define TW_SLOTS        (1 << TW_SLOT_BITS)
+#define TW_SLOT_MASK    (TW_SLOTS - 1)
+#define TW_LEVELS       4
+
+/* Intrusive doubly linked list, every slot has a sentinel. */
+struct tw_link {
+    struct tw_link *prev;
+    struct tw_link *next;
+};
+
+typedef struct timing_wheel_timer tw_timer_t;
+typedef void (*tw_callback_t)(tw_timer_t *timer, void *arg);
+
+/* Embedded in the caller's own structure, never allocated by the wheel. */
+struct timing_wheel_timer {
+    struct tw_link link;    // first member, @link.next is nullptr if not pending.
+    uint64_t expires;       // absolute tick.
+    tw_callback_t callback;
+    void *arg;
+};
+
+typedef struct timing_wheel {
+    uint64_t now;           // current tick.
+    size_t count;           // pending timers.
+    struct tw_link slots[TW_LEVELS][TW_SLOTS];
+} timing_wheel_t;
+
+/*  New a timing wheel starting at tick @now. nullptr returned if failed. */
+extern timing_wheel_t* tw_new(uint64_t now);
+
+/*  Initialize @timer (not pending) with its expiry @callback and @arg. */
+extern void tw_timer_init(tw_timer_t *timer, tw_callback_t callback, void *arg);
+
+/*  Expire @timer @delay ticks from now (at least 1), O(1). A pending @timer is
+    rescheduled. -1 returned if failed.
+ */
+extern int tw_schedule(timing_wheel_t *tw, tw_timer_t *timer, uint64_t delay);
+
+/*  Cancel a pending @timer, O(1). -1 returned if failed or not pending. */
+extern int tw_cancel(timing_wheel_t *tw, tw_timer_t *timer);
+
+/*  Move the wheel @ticks forward, and call the callback of every timer expired.
+    All the timers of a tick are detached from the wheel at once before their
+    callbacks run, so a callback may schedule or cancel any timer (itself included).
+    Return how many timers expired.
+ */
+extern size_t tw_advance(timing_wheel_t *tw, uint64_t ticks);
+
+/* -1 returned if failed. Pending timers are simply forgotten (owned by the caller). */
+extern int tw_destroy(timing_wheel_t *tw);
+
+#define tw_timer_pending(timer) ((timer)->link.next != nullptr)
+#define tw_count(tw) ((tw)->count)
+
+#endif // SAKUC_TIMING_WHEEL_H_
@@ -0,0 +1,198 @@
+// 2026-10-19 - type-specialized, header-inline variant of sakuc_deque_t.
+
+#ifndef SAKUC_TYPED_DEQUE_H_
+#define SAKUC_TYPED_DEQUE_H_
+
+#include "common_defs.h"
+#include "common_memory_management_defs.h"
+
+/*  SAKUC_DEQUE_DEFINE(name, T, BLOCK) defines a deque of @T, in blocks of @BLOCK
+    elements (a compile-time constant, power of 2 preferred):
+        name_t                          - the deque type.
+        name_new()                      - nullptr returned if failed.
+        name_push_back(dq, value)       - -1 returned if failed.
+        name_push_front(dq, value)      - -1 returned if failed.
+        name_pop_front(dq, &value)      - nullptr returned if empty.
+        name_pop_back(dq, &value)       - nullptr returned if empty.
+        name_at(dq, i)                  - pointer to the @i-th element (0 - front),
+                                          nullptr returned if out of range.
+        name_peek_front(dq) / name_peek_back(dq)
+        name_length(dq)
+        name_destroy(dq)                - -1 returned if failed.
+
+    Like sakuc_deque_t's block map, @map points to the blocks, and the elements are
+    the positions [@first, @last) of the virtual array of (@map_size * BLOCK) slots,
+    so position p is @map[p / BLOCK][p % BLOCK]: every operation is an index
+    computation and one assignment, inlined, with no @len nor memcpy. A block is
+    allocated when the first slot of it is written, and released once its last
+    element is popped; the last released one is kept in @spare, so that a queue
+    going back and forth across a block boundary doesn't call malloc.
+
+    eg. SAKUC_DEQUE_DEFINE(ptr_deque, void *, 64)
+        ptr_deque_t *dq = ptr_deque_new();
+        ptr_deque_push_back(dq, p);
+ */
+#define SAKUC_DEQUE_DEFINE(name, T, BLOCK)                                      \
+                                                                                \
+typedef struct name {                                                           \
+    T **map;                                                                    \
+    size_t map_size;                                                            \
+    size_t capacity;    /* map_size * BLOCK */                                  \
+    size_t first;       /* position of the front element */                     \
+    size_t last;        /* position after the back element */                   \
+    T *spare;                                                                   \
+} name##_t;                                                                     \
+                                                                                \
+static inline name##_t *name##_new(void)                                        \
+{                                                                               \
+    name##_t *dq = (name##_t *) osal_mem_alloc(sizeof(name##_t));               \
+    if (!dq)                                                                    \
+        return nullptr;                                                         \
+    dq->map_size = 8;                                                           \
+    dq->map = (T **) osal_mem_calloc(dq->map_size, sizeof(T *));                \
+    if (!dq->map) {                                                             \
+        osal_mem_free(dq);                                                      \
+        return nullptr;                                                         \
+    }                                                                           \
+    dq->capacity = dq->map_size * (BLOCK);                                      \
+    dq->first = dq->last = dq->capacity / 2; /* room on both sides */           \
+    dq->spare = nullptr;                                                        \
+    return dq;                                                                  \
+}                                                                               \
+                                                                                \
+/* slow path: recenter the used blocks within a new map, doubled if more than   \
+   half used, once @first hits 0 or @last hits @capacity. */                    \
+static inline int name##_remap_(name##_t *dq)                                   \
+{                                                                               \
+    size_t first_block = dq->first / (BLOCK);                                   \
+    size_t num_blocks = dq->last / (BLOCK) - first_block + 1;                   \
+    size_t map_size = dq->map_size;                                             \
+    if (2 * num_blocks + 2 > map_size)                                          \
+        map_size *= 2;                                                          \
+    T **map = (T **) osal_mem_calloc(map_size, sizeof(T *));                    \
+    if (!map)                                                                   \
+        return -1;                                                              \
+                                                                                \
+    /* blocks are allocated only within [first / BLOCK, last / BLOCK]. */       \
+    size_t new_first_block = (map_size - num_blocks) / 2;                       \
+    for (size_t i = 0; i < num_blocks && first_block + i < dq->map_size; i++)   \
+        map[new_first_block + i] = dq->map[first_block + i];                    \
+    size_t length = dq->last - dq->first;                                       \
+    dq->first = new_first_block * (BLOCK) + dq->first % (BLOCK);                \
+    dq->last = dq->first + length;                                              \
+    osal_mem_free(dq->map);                                                     \
+    dq->map = map;                                                              \
+    dq->map_size = map_size;                                                    \
+    dq->capacity = map_size * (BLOCK);                                          \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+/* slow path: the block holding position @pos, from @spare or allocated. */     \
+static inline T *name##_block_new_(name##_t *dq, size_t pos)                    \
+{                                                                               \
+    T *block = dq->spare;                                                       \
+    if (block)                                                                  \
+        dq->spare = nullptr;                                                    \
+    else {                                                                      \
+        block = (T *) osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,             \
+                                             (BLOCK) * sizeof(T));              \
+        if (!block)                                                             \
+            return nullptr;                                                     \
+    }                                                                           \
+    dq->map[pos / (BLOCK)] = block;                                             \
+    return block;                                                               \
+}                                                                               \
+                                                                                \
+static inline void name##_block_release_(name##_t *dq, size_t block_index)      \
+{                                                                               \
+    if (dq->spare)                                                              \
+        osal_mem_aligned_free(dq->spare);                                       \
+    dq->spare = dq->map[block_index];                                           \
+    dq->map[block_index] = nullptr;                                             \
+}                                                                               \
+                                                                                \
+static inline int name##_push_back(name##_t *dq, T value)                       \
+{                                                                               \
+    if (dq->last == dq->capacity && name##_remap_(dq) == -1)                    \
+        return -1;                                                              \
+    T *block = dq->map[dq->last / (BLOCK)];                                     \
+    if (!block && !(block = name##_block_new_(dq, dq->last)))                   \
+        return -1;                                                              \
+    block[dq->last % (BLOCK)] = value;                                          \
+    dq->last += 1;                                                              \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+static inline int name##_push_front(name##_t *dq, T value)                      \
+{                                                                               \
+    if (dq->first == 0 && name##_remap_(dq) == -1)                              \
+        return -1;                                                              \
+    size_t pos = dq->first - 1;                                                 \
+    T *block = dq->map[pos / (BLOCK)];                                          \
+    if (!block && !(block = name##_block_new_(dq, pos)))                        \
+        return -1;                                                              \
+    block[pos % (BLOCK)] = value;                                               \
+    dq->first = pos;                                                            \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+static inline T *name##_pop_front(name##_t *dq, T *pop_value)                   \
+{                                                                               \
+    if (dq->first == dq->last)                                                  \
+        return nullptr;                                                         \
+    *pop_value = dq->map[dq->first / (BLOCK)][dq->first % (BLOCK)];             \
+    dq->first += 1;                                                             \
+    if (dq->first % (BLOCK) == 0) /* the block before is consumed */            \
+        name##_block_release_(dq, dq->first / (BLOCK) - 1);                     \
+    return pop_value;                                                           \
+}                                                                               \
+                                                                                \
+static inline T *name##_pop_back(name##_t *dq, T *pop_value)                    \
+{                                                                               \
+    if (dq->first == dq->last)                                                  \
+        return nullptr;                                                         \
+    dq->last -= 1;                                                              \
+    *pop_value = dq->map[dq->last / (BLOCK)][dq->last % (BLOCK)];               \
+    if (dq->last % (BLOCK) == 0) /* nothing left within this block */           \
+        name##_block_release_(dq, dq->last / (BLOCK));                          \
+    return pop_value;                                                           \
+}                                                                               \
+                                                                                \
+static inline T *name##_at(name##_t *dq, size_t i)                              \
+{                                                                               \
+    if (i >= dq->last - dq->first)                                              \
+        return nullptr;                                                         \
+    size_t pos = dq->first + i;                                                 \
+    return &dq->map[pos / (BLOCK)][pos % (BLOCK)];                              \
+}                                                                               \
+                                                                                \
+static inline T *name##_peek_front(name##_t *dq)                                \
+{                                                                               \
+    return name##_at(dq, 0);                                                    \
+}                                                                               \
+                                                                                \
+static inline T *name##_peek_back(name##_t *dq)                                 \
+{                                                                               \
+    return name##_at(dq, dq->last - dq->first - 1);                             \
+}                                                                               \
+                                                                                \
+static inline size_t name##_length(const name##_t *dq)                          \
+{                                                                               \
+    return dq->last - dq->first;                                                \
+}                                                                               \
+                                                                                \
+static inline int name##_destroy(name##_t *dq)                                  \
+{                                                                               \
+    if (!dq || !dq->map)                                                        \
+        return -1;                                                              \
+    for (size_t i = 0; i < dq->map_size; i++)                                   \
+        if (dq->map[i])                                                         \
+            osal_mem_aligned_free(dq->map[i]);                                  \
+    if (dq->spare)                                                              \
+        osal_mem_aligned_free(dq->spare);                                       \
+    osal_mem_free(dq->map);                                                     \
+    osal_mem_free(dq);                                                          \
+    return 0;                                                                   \
+}
+
+#endif // SAKUC_TYPED_DEQUE_H_
@@ -0,0 +1,90 @@
+// 2026-10-19 - type-specialized, header-inline variant of ringbuffer_t.
+
+#ifndef SAKUC_TYPED_RINGBUFFER_H_
+#define SAKUC_TYPED_RINGBUFFER_H_
+
+#include "common_defs.h"
+#include "common_memory_management_defs.h"
+
+/*  SAKUC_RINGBUFFER_DEFINE(name, T) defines a FIFO of @T:
+        name_t                          - the ringbuffer type.
+        name_new(capacity)              - @capacity rounded up to power of 2,
+                                          nullptr returned if failed.
+        name_push_back(rb, value)       - overwrite the oldest one when full, like
+                                          #rbuf_push_back. always 0.
+        name_pop_front(rb, &value)      - nullptr returned if empty.
+        name_length(rb)
+        name_destroy(rb)                - -1 returned if failed.
+    
+    Unlike ringbuffer_t, all operations are static inline, values are assigned
+    instead of memcpy-ed, and @start / @end are free-running counters masked by
+    (capacity - 1), so there is no compare-and-wrap on each access.
+    
+    eg. SAKUC_RINGBUFFER_DEFINE(u32_rbuf, uint32_t)
+        u32_rbuf_t *rb = u32_rbuf_new(1024);
+        u32_rbuf_push_back(rb, 42);
+ */
+#define SAKUC_RINGBUFFER_DEFINE(name, T)                                        \
+                                                                                \
+typedef struct name {                                                           \
+    size_t capacity;    /* power of 2 */                                        \
+    size_t mask;        /* capacity - 1 */                                      \
+    size_t start;       /* free-running, slot = (start & mask) */               \
+    size_t end;         /* free-running, length = end - start */                \
+    T *buffer;                                                                  \
+} name##_t;                                                                     \
+                                                                                \
+static inline name##_t *name##_new(size_t capacity)                             \
+{                                                                               \
+    if (capacity == 0)                                                          \
+        return nullptr;                                                         \
+    size_t pow2 = 1;                                                            \
+    while (pow2 < capacity)                                                     \
+        pow2 <<= 1;                                                             \
+                                                                                \
+    name##_t *rb = (name##_t *) osal_mem_alloc(sizeof(name##_t));               \
+    if (!rb)                                                                    \
+        return nullptr;                                                         \
+    rb->buffer = (T *) osal_mem_alloc(pow2 * sizeof(T));                        \
+    if (!rb->buffer) {                                                          \
+        osal_mem_free(rb);                                                      \
+        return nullptr;                                                         \
+    }                                                                           \
+    rb->capacity = pow2; rb->mask = pow2 - 1;                                   \
+    rb->start = rb->end = 0;                                                    \
+    return rb;                                                                  \
+}                                                                               \
+                                                                                \
+static inline int name##_push_back(name##_t *rb, T value)                       \
+{                                                                               \
+    rb->buffer[rb->end & rb->mask] = value;                                     \
+    rb->end += 1;                                                               \
+    if (rb->end - rb->start > rb->capacity)                                     \
+        rb->start += 1; /* full, the oldest one is overwritten. */              \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+static inline T *name##_pop_front(name##_t *rb, T *pop_value)                   \
+{                                                                               \
+    if (rb->start == rb->end)                                                   \
+        return nullptr;                                                         \
+    *pop_value = rb->buffer[rb->start & rb->mask];                              \
+    rb->start += 1;                                                             \
+    return pop_value;                                                           \
+}                                                                               \
+                                                                                \
+static inline size_t name##_length(const name##_t *rb)                          \
+{                                                                               \
+    return rb->end - rb->start;                                                 \
+}                                                                               \
+                                                                                \
+static inline int name##_destroy(name##_t *rb)                                  \
+{                                                                               \
+    if (!rb || !rb->buffer)                                                     \
+        return -1;                                                              \
+    osal_mem_free(rb->buffer);                                                  \
+    osal_mem_free(rb);                                                          \
+    return 0;                                                                   \
+}
+
+#endif // SAKUC_TYPED_RINGBUFFER_H_
@@ -0,0 +1,151 @@
+// 2026-10-19 - Chase-Lev lock-free work-stealing deque.
+
+#include "ws_deque.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+/* the slots are accessed atomically (relaxed) as the owner and thieves may race on them. */
+#define ws_slot_(a, i) (&(a)->slots[(size_t)(i) & (a)->mask])
+
+static struct ws_deque_array_ *ws_deque_array_new_(size_t size)
+{
+    struct ws_deque_array_ *a = (struct ws_deque_array_ *)
+        osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,
+                               sizeof(struct ws_deque_array_) + size * sizeof(void *));
+    if (!a)
+        return nullptr;
+    a->size = size;
+    a->mask = size - 1;
+    a->prev = nullptr;
+    return a;
+}
+
+/* double the array holding [@top, @bottom), nullptr if failed. */
+static struct ws_deque_array_ *ws_deque_grow_(ws_deque_t *dq, struct ws_deque_array_ *a,
+                                              intptr_t top, intptr_t bottom)
+{
+    struct ws_deque_array_ *bigger = ws_deque_array_new_(a->size << 1);
+    if (!bigger)
+        return nullptr;
+    
+    for (intptr_t i = top; i < bottom; i++)
+        osal_atomic_store_relaxed(ws_slot_(bigger, i), osal_atomic_load_relaxed(ws_slot_(a, i)));
+    bigger->prev = a;
+    // thieves loading the new array must see the copied slots.
+    osal_atomic_store_release(&dq->array, bigger);
+    return bigger;
+}
+
+ws_deque_t *ws_deque_new(size_t capacity)
+{
+    size_t pow2 = 2;
+    while (pow2 < capacity)
+        pow2 <<= 1;
+    
+    ws_deque_t *dq = (ws_deque_t *) osal_mem_aligned_alloc(SAKUC_CACHE_LINE_SIZE,
+                                                           sizeof(ws_deque_t));
+    if (!dq)
+        return nullptr;
+    
+    dq->array = ws_deque_array_new_(pow2);
+    if (!dq->array) {
+        osal_mem_aligned_free(dq);
+        return nullptr;
+    }
+    dq->top.index = dq->bottom.index = 0;
+    return dq;
+}
+
+int ws_deque_push_bottom(ws_deque_t *dq, void *task)
+{
+    if (!dq || !task)
+        return -1;
+    
+    intptr_t b = osal_atomic_load_relaxed(&dq->bottom.index);
+    intptr_t t = osal_atomic_load_acquire(&dq->top.index);
+    struct ws_deque_array_ *a = osal_atomic_load_relaxed(&dq->array);
+    
+    if (b - t > (intptr_t) a->size - 1) {
+        a = ws_deque_grow_(dq, a, t, b);
+        if (!a)
+            return -1;
+    }
+    
+    osal_atomic_store_relaxed(ws_slot_(a, b), task);
+    // thieves seeing the new @bottom must see @task (a release fence in the paper).
+    osal_atomic_store_release(&dq->bottom.index, b + 1);
+    return 0;
+}
+
+void *ws_deque_pop_bottom(ws_deque_t *dq)
+{
+    if (!dq)
+        return nullptr;
+    
+    intptr_t b = osal_atomic_load_relaxed(&dq->bottom.index) - 1;
+    struct ws_deque_array_ *a = osal_atomic_load_relaxed(&dq->array);
+    osal_atomic_store_relaxed(&dq->bottom.index, b);
+    // the store to @bottom must be visible before reading @top, see #ws_deque_steal.
+    osal_atomic_fence_seq_cst();
+    intptr_t t = osal_atomic_load_relaxed(&dq->top.index);
+    
+    void *task = nullptr;
+    if (t <= b) {
+        task = osal_atomic_load_relaxed(ws_slot_(a, b));
+        if (t == b) {
+            // the last one, race against the thieves for it.
+            if (!osal_atomic_cas_strong_seq_cst(&dq->top.index, &t, t + 1))
+                task = nullptr;
+            osal_atomic_store_relaxed(&dq->bottom.index, b + 1);
+        }
+    }
+    else {
+        // empty, restore @bottom.
+        osal_atomic_store_relaxed(&dq->bottom.index, b + 1);
+    }
+    return task;
+}
+
+void *ws_deque_steal(ws_deque_t *dq)
+{
+    if (!dq)
+        return nullptr;
+    
+    intptr_t t = osal_atomic_load_acquire(&dq->top.index);
+    osal_atomic_fence_seq_cst();
+    intptr_t b = osal_atomic_load_acquire(&dq->bottom.index);
+    
+    if (t >= b)
+        return nullptr;
+    
+    struct ws_deque_array_ *a = osal_atomic_load_acquire(&dq->array);
+    void *task = osal_atomic_load_relaxed(ws_slot_(a, t));
+    if (!osal_atomic_cas_strong_seq_cst(&dq->top.index, &t, t + 1))
+        return nullptr;
+    return task;
+}
+
+size_t ws_deque_length(ws_deque_t *dq)
+{
+    if (!dq)
+        return 0;
+    
+    intptr_t b = osal_atomic_load_relaxed(&dq->bottom.index);
+    intptr_t t = osal_atomic_load_relaxed(&dq->top.index);
+    return b > t ? (size_t)(b - t) : 0;
+}
+
+int ws_deque_destroy(ws_deque_t *dq)
+{
+    if (!dq)
+        return -1;
+    
+    struct ws_deque_array_ *a = dq->array;
+    while (a) {
+        struct ws_deque_array_ *prev = a->prev;
+        osal_mem_aligned_free(a);
+        a = prev;
+    }
+    osal_mem_aligned_free(dq);
+    return 0;
+}
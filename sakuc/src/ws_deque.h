@@ -0,0 +1,64 @@
+// 2026-10-19 - Chase-Lev lock-free work-stealing deque.
+
+#ifndef SAKUC_WS_DEQUE_H_
+#define SAKUC_WS_DEQUE_H_
+
+#include <stdint.h>
+#include "common_defs.h"
+
+/*  Chase-Lev work-stealing deque, following the C11 version of
+        N.M. Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models",
+        PPoPP 2013.
+    
+    Only the owner thread pushes and pops at the bottom (LIFO, cache friendly), any
+    other thread ("thief") steals from the top (FIFO) by CAS on @top, so the owner
+    only contends with thieves when one element is left.
+    
+    Elements are task pointers (nullptr is not a valid element). The circular array
+    doubles when full, like sakuc_deque_t growing by blocks; a thief may still read the
+    retired array, so retired arrays are chained by @prev until #ws_deque_destroy
+    (they sum up to less than the current array).
+ */
+struct ws_deque_array_ {
+    size_t size;    // power of 2.
+    size_t mask;    // size - 1.
+    struct ws_deque_array_ *prev; // retired before this one.
+    void *slots[];
+};
+
+struct ws_deque_index_ {
+    intptr_t index;
+    char pad[SAKUC_CACHE_LINE_SIZE - sizeof(intptr_t)];
+};
+
+typedef struct ws_deque {
+    struct ws_deque_index_ top;     // written by thieves (and the owner taking the last one).
+    struct ws_deque_index_ bottom;  // written by the owner only.
+    struct ws_deque_array_ *array;  // replaced by the owner only.
+} ws_deque_t;
+
+/*  New a work-stealing deque with @capacity slots initially (rounded up to power
+    of 2, at least 2). nullptr returned if failed to allocate memory.
+ */
+extern ws_deque_t *ws_deque_new(size_t capacity);
+
+/*  Owner only. Push @task to the bottom, grow the array if full.
+    -1 returned if @task is nullptr or failed to grow.
+ */
+extern int ws_deque_push_bottom(ws_deque_t *dq, void *task);
+
+/* Owner only. Pop the most recently pushed task, nullptr returned if empty. */
+extern void *ws_deque_pop_bottom(ws_deque_t *dq);
+
+/*  Any thread. Steal the oldest task, nullptr returned if empty or lost the race
+    against another thief (or the owner) - try again or try another victim.
+ */
+extern void *ws_deque_steal(ws_deque_t *dq);
+
+/* approximate when used concurrently. */
+extern size_t ws_deque_length(ws_deque_t *dq);
+
+/* -1 returned if failed. No thread may use @dq any more. */
+extern int ws_deque_destroy(ws_deque_t *dq);
+
+#endif // SAKUC_WS_DEQUE_H_
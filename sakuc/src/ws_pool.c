@@ -0,0 +1,282 @@
+// 2026-10-19 - fork/join worker pool on top of the work-stealing deque.
+
+#define _GNU_SOURCE // sched_yield
+
+#include <sched.h>
+#include "ws_pool.h"
+#include "common_atomic_defs.h"
+#include "common_memory_management_defs.h"
+
+// idle rounds (looking for a task) before a worker goes to sleep.
+#define WS_POOL_IDLE_SPINS 256
+
+/* xorshift64, @state must not be 0. */
+static uint64_t ws_pool_rand_(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/* any task queued anywhere? approximate, only used before going to sleep. */
+static int ws_pool_has_task_(ws_pool_t *pool)
+{
+    if (mpmc_rbuf_length(pool->inbox) > 0)
+        return TRUE;
+    for (size_t i = 0; i < pool->num_workers; i++)
+        if (ws_deque_length(pool->workers[i].dq) > 0)
+            return TRUE;
+    return FALSE;
+}
+
+/* a task was queued, wake up one idle worker if any. */
+static void ws_pool_notify_(ws_pool_t *pool)
+{
+    // pairs with the fence of #ws_pool_sleep_: either the sleeper sees the task,
+    // or we see the sleeper.
+    osal_atomic_fence_seq_cst();
+    if (osal_atomic_load_relaxed(&pool->num_sleepers) == 0)
+        return;
+    
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->wakeup);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void ws_pool_sleep_(ws_pool_t *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    osal_atomic_fetch_add(&pool->num_sleepers, 1);
+    osal_atomic_fence_seq_cst();
+    if (!osal_atomic_load_relaxed(&pool->stop) && !ws_pool_has_task_(pool))
+        pthread_cond_wait(&pool->wakeup, &pool->lock);
+    osal_atomic_fetch_sub(&pool->num_sleepers, 1);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static struct ws_task *ws_pool_find_task_(struct ws_worker *w)
+{
+    ws_pool_t *pool = w->pool;
+    struct ws_task *task = ws_deque_pop_bottom(w->dq);
+    if (task)
+        return task;
+    
+    if (mpmc_rbuf_pop_front(pool->inbox, &task, sizeof(task)))
+        return task;
+    
+    if (pool->num_workers == 1)
+        return nullptr;
+    for (size_t i = 0; i < 2 * pool->num_workers; i++) {
+        size_t victim = (size_t) (ws_pool_rand_(&w->seed) % pool->num_workers);
+        if (victim == w->id)
+            continue;
+        task = ws_deque_steal(pool->workers[victim].dq);
+        if (task) {
+            ++ w->steals;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+static void ws_pool_run_(struct ws_worker *w, struct ws_task *task)
+{
+    // @task may be gone once it has run, and @group once it is finished.
+    struct ws_group *group = task->group;
+    int submitted = group && osal_atomic_load_relaxed(&group->submitted);
+    task->run(w, task);
+    ++ w->executed;
+    
+    if (group && osal_atomic_fetch_sub(&group->pending, 1) == 1 && submitted) {
+        // pairs with the fence of #ws_pool_wait.
+        osal_atomic_fence_seq_cst();
+        if (osal_atomic_load_relaxed(&w->pool->num_waiters) > 0) {
+            pthread_mutex_lock(&w->pool->lock);
+            pthread_cond_broadcast(&w->pool->done);
+            pthread_mutex_unlock(&w->pool->lock);
+        }
+    }
+}
+
+static void *ws_pool_worker_thread_(void *arg)
+{
+    struct ws_worker *w = arg;
+    size_t idle = 0;
+    
+    while (!osal_atomic_load_acquire(&w->pool->stop)) {
+        struct ws_task *task = ws_pool_find_task_(w);
+        if (task) {
+            ws_pool_run_(w, task);
+            idle = 0;
+        }
+        else if (++idle < WS_POOL_IDLE_SPINS) {
+            if (idle % 64 == 0)
+                sched_yield();
+            else
+                osal_cpu_relax();
+        }
+        else {
+            ws_pool_sleep_(w->pool);
+            idle = 0;
+        }
+    }
+    return nullptr;
+}
+
+/* stop and join the first @num_started workers. */
+static void ws_pool_stop_(ws_pool_t *pool, size_t num_started)
+{
+    pthread_mutex_lock(&pool->lock);
+    osal_atomic_store_release(&pool->stop, TRUE);
+    pthread_cond_broadcast(&pool->wakeup);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (size_t i = 0; i < num_started; i++)
+        pthread_join(pool->workers[i].thread, nullptr);
+}
+
+static void ws_pool_free_(ws_pool_t *pool)
+{
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wakeup);
+    pthread_mutex_destroy(&pool->lock);
+    mpmc_rbuf_destroy(pool->inbox);
+    for (size_t i = 0; i < pool->num_workers; i++)
+        ws_deque_destroy(pool->workers[i].dq);
+    osal_mem_free(pool->workers);
+    osal_mem_free(pool);
+}
+
+ws_pool_t *ws_pool_new(size_t num_workers, size_t inbox_capacity)
+{
+    if (num_workers == 0)
+        return nullptr;
+    
+    ws_pool_t *pool = (ws_pool_t *) osal_mem_alloc(sizeof(ws_pool_t));
+    if (!pool)
+        return nullptr;
+    
+    pool->num_workers = num_workers;
+    pool->stop = FALSE;
+    pool->num_sleepers = pool->num_waiters = 0;
+    pool->workers = (struct ws_worker *) osal_mem_calloc(num_workers, sizeof(struct ws_worker));
+    pool->inbox = mpmc_rbuf_new(inbox_capacity, sizeof(struct ws_task *));
+    if (!pool->workers || !pool->inbox)
+        goto ws_pool_new_failed;
+    
+    for (size_t i = 0; i < num_workers; i++) {
+        struct ws_worker *w = &pool->workers[i];
+        w->pool = pool;
+        w->id = i;
+        w->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+        w->dq = ws_deque_new(64);
+        if (!w->dq)
+            goto ws_pool_new_failed;
+    }
+    
+    pthread_mutex_init(&pool->lock, nullptr);
+    pthread_cond_init(&pool->wakeup, nullptr);
+    pthread_cond_init(&pool->done, nullptr);
+    
+    for (size_t i = 0; i < num_workers; i++) {
+        if (pthread_create(&pool->workers[i].thread, nullptr,
+                           ws_pool_worker_thread_, &pool->workers[i]) != 0) {
+            // stop the ones started already, and clean up everything.
+            ws_pool_stop_(pool, i);
+            ws_pool_free_(pool);
+            return nullptr;
+        }
+    }
+    return pool;
+
+ws_pool_new_failed:
+    if (pool->workers) {
+        for (size_t i = 0; i < num_workers; i++)
+            if (pool->workers[i].dq)
+                ws_deque_destroy(pool->workers[i].dq);
+        osal_mem_free(pool->workers);
+    }
+    if (pool->inbox)
+        mpmc_rbuf_destroy(pool->inbox);
+    osal_mem_free(pool);
+    return nullptr;
+}
+
+int ws_pool_submit(ws_pool_t *pool, struct ws_group *group, struct ws_task *task)
+{
+    if (!pool || !task || !task->run)
+        return -1;
+    
+    task->group = group;
+    if (group) {
+        osal_atomic_store_relaxed(&group->submitted, TRUE);
+        osal_atomic_fetch_add(&group->pending, 1);
+    }
+    if (mpmc_rbuf_push_back(pool->inbox, &task, sizeof(task)) == -1) {
+        if (group)
+            osal_atomic_fetch_sub(&group->pending, 1);
+        return -1;
+    }
+    ws_pool_notify_(pool);
+    return 0;
+}
+
+int ws_pool_spawn(struct ws_worker *w, struct ws_group *group, struct ws_task *task)
+{
+    if (!w || !task || !task->run)
+        return -1;
+    
+    task->group = group;
+    if (group)
+        osal_atomic_fetch_add(&group->pending, 1);
+    if (ws_deque_push_bottom(w->dq, task) == -1) {
+        if (group)
+            osal_atomic_fetch_sub(&group->pending, 1);
+        return -1;
+    }
+    ws_pool_notify_(w->pool);
+    return 0;
+}
+
+void ws_worker_wait(struct ws_worker *w, struct ws_group *group)
+{
+    size_t idle = 0;
+    while (osal_atomic_load_acquire(&group->pending) > 0) {
+        // help instead of blocking: the tasks of @group are most likely on top of our
+        // own deque, or being run by a thief who will finish them for us.
+        struct ws_task *task = ws_pool_find_task_(w);
+        if (task) {
+            ws_pool_run_(w, task);
+            idle = 0;
+        }
+        else if (++idle % 64 == 0)
+            sched_yield();
+        else
+            osal_cpu_relax();
+    }
+}
+
+void ws_pool_wait(ws_pool_t *pool, struct ws_group *group)
+{
+    if (!pool || !group)
+        return;
+    
+    pthread_mutex_lock(&pool->lock);
+    osal_atomic_fetch_add(&pool->num_waiters, 1);
+    osal_atomic_fence_seq_cst();
+    while (osal_atomic_load_acquire(&group->pending) > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    osal_atomic_fetch_sub(&pool->num_waiters, 1);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int ws_pool_destroy(ws_pool_t *pool)
+{
+    if (!pool)
+        return -1;
+    
+    ws_pool_stop_(pool, pool->num_workers);
+    ws_pool_free_(pool);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// 2026-10-19 - fork/join worker pool on top of the work-stealing deque.
+
+#ifndef SAKUC_WS_POOL_H_
+#define SAKUC_WS_POOL_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include "common_defs.h"
+#include "ws_deque.h"
+#include "mpmc_ringbuffer.h"
+
+/*  Every worker thread owns a ws_deque_t: tasks spawned by a running task are pushed
+    to (and popped from) the bottom of its own deque, idle workers steal from the top
+    of a random victim. Tasks submitted from outside the pool go through @inbox.
+    Workers with nothing to do spin a little, then sleep on @wakeup.
+    
+    Tasks are intrusive, like struct timing_wheel_timer: embed a struct ws_task into
+    your own struct and recover it within @run. The memory of a task belongs to the
+    caller and must stay valid until the task has run.
+    
+    A struct ws_group counts the tasks not finished yet, to join them:
+    
+        struct fib { struct ws_task task; int n; long result; };
+    
+        static void fib_run(struct ws_worker *w, struct ws_task *task)
+        {
+            struct fib *f = (struct fib *) task;
+            struct fib child = { .task.run = fib_run, .n = f->n - 1 };
+            struct ws_group group = WS_GROUP_INIT;
+            ...
+            ws_pool_spawn(w, &group, &child.task);  // fork
+            ...                                     // run something else meanwhile
+            ws_worker_wait(w, &group);              // join, runs other tasks meanwhile
+        }
+ */
+struct ws_worker;
+
+struct ws_task {
+    void (*run)(struct ws_worker *w, struct ws_task *task);
+    struct ws_group *group; // set by #ws_pool_spawn / #ws_pool_submit.
+};
+
+struct ws_group {
+    size_t pending; // tasks spawned (submitted) within this group and not finished yet.
+    int submitted;  // any task submitted from outside, only those groups wake up #ws_pool_wait.
+};
+
+#define WS_GROUP_INIT { 0, FALSE }
+
+struct ws_worker {
+    struct ws_pool *pool;
+    ws_deque_t *dq;
+    size_t id;
+    uint64_t seed;      // victim selection.
+    pthread_t thread;
+    // statistics, written by this worker only.
+    size_t executed;
+    size_t steals;
+};
+
+typedef struct ws_pool {
+    size_t num_workers;
+    struct ws_worker *workers;
+    mpmc_ringbuffer_t *inbox;   // struct ws_task * submitted from outside the pool.
+    int stop;
+    
+    // idle workers and outside waiters sleep on the condition variables.
+    size_t num_sleepers;
+    size_t num_waiters;
+    pthread_mutex_t lock;
+    pthread_cond_t wakeup;      // new task for idle workers.
+    pthread_cond_t done;        // a group finished, for #ws_pool_wait.
+} ws_pool_t;
+
+/*  New a pool of @num_workers threads (at least 1), tasks submitted from outside
+    the pool are queued up to @inbox_capacity. nullptr returned if failed.
+ */
+extern ws_pool_t *ws_pool_new(size_t num_workers, size_t inbox_capacity);
+
+/*  Outside the pool only. Queue @task within @group (nullptr if not joined).
+    -1 returned if failed or the inbox is full.
+ */
+extern int ws_pool_submit(ws_pool_t *pool, struct ws_group *group, struct ws_task *task);
+
+/*  Within a running task only (@w is the worker running it). Fork @task within
+    @group (nullptr if not joined). -1 returned if failed.
+ */
+extern int ws_pool_spawn(struct ws_worker *w, struct ws_group *group, struct ws_task *task);
+
+/* Within a running task only. Join @group: run other tasks until it is finished. */
+extern void ws_worker_wait(struct ws_worker *w, struct ws_group *group);
+
+/* Outside the pool only. Block until @group is finished. */
+extern void ws_pool_wait(ws_pool_t *pool, struct ws_group *group);
+
+/*  Stop and join all the workers, tasks not run yet are dropped.
+    -1 returned if failed. Must not be called from a task.
+ */
+extern int ws_pool_destroy(ws_pool_t *pool);
+
+#endif // SAKUC_WS_POOL_H_
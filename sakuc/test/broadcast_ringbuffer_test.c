@@ -0,0 +1,137 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../src/broadcast_ringbuffer.h"
+#include "common_test_defs.h"
+#include "broadcast_ringbuffer_test.h"
+
+#define NUM_CONSUMERS 3
+#define NUM_MESSAGES 100000
+
+struct consumer_ctx {
+    broadcast_ringbuffer_t *rb;
+    int id;
+    size_t received;
+    size_t lost;
+    int in_order;
+};
+
+static void *consumer_thread(void *arg)
+{
+    struct consumer_ctx *ctx = arg;
+    size_t value, lost;
+    size_t expected = 0;
+    while (expected < NUM_MESSAGES) {
+        if (bcast_rbuf_pop_front(ctx->rb, ctx->id, &value, sizeof(value), &lost) == nullptr) {
+            expected += lost;
+            ctx->lost += lost;
+            sched_yield();
+            continue;
+        }
+        // every consumer sees every element in order, minus the reported losses.
+        expected += lost;
+        ctx->lost += lost;
+        if (value != expected)
+            ctx->in_order = FALSE;
+        ++ expected;
+        ++ ctx->received;
+    }
+    return nullptr;
+}
+
+/* one producer, NUM_CONSUMERS consumer threads. -1 returned if failed. */
+static int run_threads(int overwrite)
+{
+    broadcast_ringbuffer_t *rb = bcast_rbuf_new(64, sizeof(size_t), NUM_CONSUMERS, overwrite);
+    if (!rb)
+        return -1;
+    
+    pthread_t consumers[NUM_CONSUMERS];
+    struct consumer_ctx ctx[NUM_CONSUMERS];
+    for (int i=0; i < NUM_CONSUMERS; i++) {
+        ctx[i] = (struct consumer_ctx) { .rb = rb, .id = bcast_rbuf_subscribe(rb), .in_order = TRUE };
+        pthread_create(&consumers[i], nullptr, consumer_thread, &ctx[i]);
+    }
+    
+    for (size_t i=0; i < NUM_MESSAGES; i++) {
+        while (bcast_rbuf_push_back(rb, &i, sizeof(i)) == -1)
+            sched_yield();
+    }
+    
+    int ret = 0;
+    for (int i=0; i < NUM_CONSUMERS; i++) {
+        pthread_join(consumers[i], nullptr);
+        if (!ctx[i].in_order || ctx[i].received + ctx[i].lost != NUM_MESSAGES
+            || (!overwrite && ctx[i].lost != 0))
+            ret = -1;
+    }
+    bcast_rbuf_destroy(rb);
+    return ret;
+}
+
+int test_broadcast_ringbuffer(void)
+{
+    size_t value, lost;
+    
+    // ## test part 1 - every consumer sees every element.
+    broadcast_ringbuffer_t *rb = bcast_rbuf_new(6, sizeof(size_t), 2, FALSE);
+    sakuc_assert(rb && rb->capacity == 8);
+    size_t zero = 0;
+    sakuc_assert(bcast_rbuf_push_back(rb, &zero, sizeof(zero)) == 0); // nobody subscribed, dropped.
+    
+    int a = bcast_rbuf_subscribe(rb);
+    int b = bcast_rbuf_subscribe(rb);
+    sakuc_assert(a >= 0 && b >= 0 && a != b && bcast_rbuf_subscribe(rb) == -1);
+    sakuc_assert(bcast_rbuf_length(rb, a) == 0);
+    
+    for (size_t i=1; i <= 8; i++)
+        sakuc_assert(bcast_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(bcast_rbuf_push_back(rb, &zero, sizeof(zero)) == -1); // gated by both.
+    
+    for (size_t i=1; i <= 8; i++) {
+        sakuc_assert(bcast_rbuf_pop_front(rb, a, &value, sizeof(value), &lost) && value == i);
+        sakuc_assert(lost == 0);
+    }
+    sakuc_assert(bcast_rbuf_pop_front(rb, a, &value, sizeof(value), nullptr) == nullptr);
+    sakuc_assert(bcast_rbuf_push_back(rb, &zero, sizeof(zero)) == -1); // still gated by @b.
+    
+    // ## test part 2 - zero-copy read of the slowest consumer releases the producer.
+    const size_t *p = bcast_rbuf_peek_front(rb, b);
+    sakuc_assert(p && *p == 1 && bcast_rbuf_consume_front(rb, b) == 0);
+    size_t nine = 9;
+    sakuc_assert(bcast_rbuf_push_back(rb, &nine, sizeof(nine)) == 0);
+    sakuc_assert(bcast_rbuf_length(rb, a) == 1 && bcast_rbuf_length(rb, b) == 8);
+    
+    // unsubscribing @b frees the producer entirely.
+    sakuc_assert(bcast_rbuf_unsubscribe(rb, b) == 0 && bcast_rbuf_unsubscribe(rb, b) == -1);
+    for (size_t i=10; i < 15; i++)
+        sakuc_assert(bcast_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(bcast_rbuf_pop_front(rb, b, &value, sizeof(value), nullptr) == nullptr);
+    
+    // a new subscriber starts with the next element.
+    b = bcast_rbuf_subscribe(rb);
+    sakuc_assert(b >= 0 && bcast_rbuf_length(rb, b) == 0);
+    sakuc_assert(bcast_rbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - overwrite mode reports the loss of a lagging consumer.
+    rb = bcast_rbuf_new(8, sizeof(size_t), 1, TRUE);
+    sakuc_assert(rb);
+    a = bcast_rbuf_subscribe(rb);
+    for (size_t i=0; i < 20; i++)
+        sakuc_assert(bcast_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(bcast_rbuf_length(rb, a) == 8);
+    sakuc_assert(bcast_rbuf_pop_front(rb, a, &value, sizeof(value), &lost) && value == 12);
+    sakuc_assert(lost == 12);
+    sakuc_assert(bcast_rbuf_pop_front(rb, a, &value, sizeof(value), &lost) && value == 13);
+    sakuc_assert(lost == 0);
+    sakuc_assert(bcast_rbuf_peek_front(rb, a) == nullptr); // zero-copy is gating mode only.
+    sakuc_assert(bcast_rbuf_destroy(rb) != -1);
+    
+    // ## test part 4 - one producer and several consumer threads.
+    sakuc_assert(run_threads(FALSE) == 0);
+    sakuc_assert(run_threads(TRUE) == 0);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef BROADCAST_RINGBUFFER_TEST_H_
+#define BROADCAST_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_broadcast_ringbuffer(void);
+
+#endif // BROADCAST_RINGBUFFER_TEST_H_
@@ -0,0 +1,148 @@
+#define _GNU_SOURCE // clock_gettime
+
+#include <pthread.h>
+#include <time.h>
+#include "../src/concurrent_deque.h"
+#include "../src/common_atomic_defs.h"
+#include "common_test_defs.h"
+#include "concurrent_deque_test.h"
+
+#define NUM_PRODUCERS 3
+#define NUM_CONSUMERS 3
+#define NUM_MESSAGES_PER_PRODUCER 50000
+
+struct message {
+    size_t producer;
+    size_t seq;
+};
+
+struct thread_ctx {
+    sakuc_cdeque_t *dq;
+    size_t id;
+    // consumer only - the next @seq expected from each producer is > last one.
+    size_t next_seq[NUM_PRODUCERS];
+    size_t received;
+    int in_order;
+};
+
+static size_t num_consumed = 0;
+
+static void *producer_thread(void *arg)
+{
+    struct thread_ctx *ctx = arg;
+    struct message msg = { .producer = ctx->id };
+    for (msg.seq = 0; msg.seq < NUM_MESSAGES_PER_PRODUCER; msg.seq++)
+        if (sakuc_cdeque_push_back(ctx->dq, &msg, sizeof(msg)) == -1)
+            break;
+    return nullptr;
+}
+
+/* blocking consumers, the ones left waiting are stopped by a (NUM_PRODUCERS, 0) message. */
+static void *consumer_thread(void *arg)
+{
+    struct thread_ctx *ctx = arg;
+    struct message msg;
+    for (;;) {
+        if (sakuc_cdeque_pop_front_timed(ctx->dq, &msg, sizeof(msg), -1) == -1)
+            break;
+        if (msg.producer == NUM_PRODUCERS)
+            break;
+        osal_atomic_fetch_add(&num_consumed, 1);
+    
+        // FIFO: messages of the same producer are seen in order by any consumer.
+        if (msg.producer > NUM_PRODUCERS || msg.seq < ctx->next_seq[msg.producer])
+            ctx->in_order = FALSE;
+        else
+            ctx->next_seq[msg.producer] = msg.seq + 1;
+        ++ ctx->received;
+    }
+    return nullptr;
+}
+
+static double elapsed_ms(const struct timespec *t0)
+{
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+}
+
+int test_concurrent_deque(void)
+{
+    // ## test part 1 - single thread, FIFO across blocks.
+    sakuc_cdeque_t *dq = sakuc_cdeque_new(4, sizeof(size_t));
+    sakuc_assert(dq && sakuc_cdeque_new(0, sizeof(size_t)) == nullptr);
+    
+    size_t value = 0;
+    sakuc_assert(sakuc_cdeque_pop_front(dq, &value, sizeof(size_t)) == -1);
+    for (size_t i = 0; i < 10; i++)
+        sakuc_assert(sakuc_cdeque_push_back(dq, &i, sizeof(size_t)) == 0);
+    sakuc_assert(sakuc_cdeque_length(dq) == 10);
+    sakuc_assert(sakuc_cdeque_push_back(dq, &value, sizeof(char)) == -1);
+    for (size_t i = 0; i < 6; i++)
+        sakuc_assert(sakuc_cdeque_pop_front(dq, &value, sizeof(size_t)) == 0 && value == i);
+    
+    // ## test part 2 - push_front on the consumers' side, within the head block and
+    //    in new blocks before it.
+    for (size_t i = 6; i > 0; i--) {
+        value = i - 1;
+        sakuc_assert(sakuc_cdeque_push_front(dq, &value, sizeof(size_t)) == 0);
+    }
+    sakuc_assert(sakuc_cdeque_length(dq) == 10);
+    for (size_t i = 10; i < 20; i++)
+        sakuc_assert(sakuc_cdeque_push_back(dq, &i, sizeof(size_t)) == 0);
+    for (size_t i = 0; i < 20; i++)
+        sakuc_assert(sakuc_cdeque_pop_front(dq, &value, sizeof(size_t)) == 0 && value == i);
+    sakuc_assert(sakuc_cdeque_length(dq) == 0 && dq->spare != nullptr);
+    
+    // ## test part 3 - blocking pop times out when empty, returns at once otherwise.
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    sakuc_assert(sakuc_cdeque_pop_front_timed(dq, &value, sizeof(size_t), 0) == -1);
+    sakuc_assert(sakuc_cdeque_pop_front_timed(dq, &value, sizeof(size_t), 50) == -1);
+    sakuc_assert(elapsed_ms(&t0) >= 49.0);
+    value = 42;
+    sakuc_assert(sakuc_cdeque_push_back(dq, &value, sizeof(size_t)) == 0);
+    sakuc_assert(sakuc_cdeque_pop_front_timed(dq, &value, sizeof(size_t), 1000) == 0 && value == 42);
+    sakuc_assert(sakuc_cdeque_destroy(dq) != -1);
+    
+    // ## test part 4 - several producers, several blocking consumers.
+    dq = sakuc_cdeque_new(64, sizeof(struct message));
+    sakuc_assert(dq);
+    
+    struct thread_ctx producers[NUM_PRODUCERS];
+    struct thread_ctx consumers[NUM_CONSUMERS];
+    pthread_t threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    num_consumed = 0;
+    
+    for (size_t i = 0; i < NUM_CONSUMERS; i++) {
+        consumers[i] = (struct thread_ctx) { .dq = dq, .id = i, .in_order = TRUE };
+        sakuc_assert(pthread_create(&threads[i], nullptr, consumer_thread, &consumers[i]) == 0);
+    }
+    for (size_t i = 0; i < NUM_PRODUCERS; i++) {
+        producers[i] = (struct thread_ctx) { .dq = dq, .id = i };
+        sakuc_assert(pthread_create(&threads[NUM_CONSUMERS + i], nullptr,
+                                    producer_thread, &producers[i]) == 0);
+    }
+    for (size_t i = 0; i < NUM_PRODUCERS; i++)
+        pthread_join(threads[NUM_CONSUMERS + i], nullptr);
+    
+    struct message stop = { .producer = NUM_PRODUCERS };
+    for (size_t i = 0; i < NUM_CONSUMERS; i++)
+        sakuc_assert(sakuc_cdeque_push_back(dq, &stop, sizeof(stop)) == 0);
+    for (size_t i = 0; i < NUM_CONSUMERS; i++)
+        pthread_join(threads[i], nullptr);
+    
+    size_t count = 0;
+    for (size_t i = 0; i < NUM_CONSUMERS; i++) {
+        sakuc_assert(consumers[i].in_order);
+        count += consumers[i].received;
+    }
+    sakuc_assert(count == NUM_PRODUCERS * NUM_MESSAGES_PER_PRODUCER && count == num_consumed);
+    sakuc_assert(sakuc_cdeque_length(dq) == 0);
+    sakuc_assert(sakuc_cdeque_destroy(dq) != -1);
+    
+    return 0;
+
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef CONCURRENT_DEQUE_TEST_H_
+#define CONCURRENT_DEQUE_TEST_H_
+
+// return -1 if test failed.
+extern int test_concurrent_deque(void);
+
+#endif // CONCURRENT_DEQUE_TEST_H_
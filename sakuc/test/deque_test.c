@@ -5,6 +5,7 @@
 #include "deque_test.h"
 
 #include <string.h>
+#include <stdint.h>
 
 // 1638 characters without suffix '\0'. (1638 = 18 * 91)
 static char mit_license[] = 
@@ -213,6 +214,308 @@ int test_deque(void)
     // ## test part 4.5 - destroy.
     sakuc_deque_destroy(dq);
     
+    // ============================== part 5 ==============================
+    // ## test part 5.1 - sakuc_deque_at, growing at both ends.
+    dq = sakuc_deque_new(7, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY);
+    sakuc_assert(dq && sakuc_deque_at(dq, 0) == nullptr);
+    
+    // front: -1, -2, ..., back: 0, 1, 2, ...
+    for (int i=0; i < 1000; i++) {
+        int neg = -1 - i;
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+        sakuc_assert(sakuc_deque_push_front(dq, &neg, sizeof(int)) == 0);
+    }
+    sakuc_assert(sakuc_deque_size(dq) == 2000 && sakuc_deque_at(dq, 2000) == nullptr);
+    for (size_t i=0; i < 2000; i++)
+        sakuc_assert(*(int *)sakuc_deque_at(dq, i) == (int) i - 1000);
+    
+    // ## test part 5.2 - still right after popping (and sweeping) at both ends.
+    int value;
+    for (int i=0; i < 333; i++) {
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i - 1000);
+        sakuc_assert(sakuc_deque_pop_back(dq, &value, sizeof(int)) == 0 && value == 999 - i);
+    }
+    sakuc_assert(sakuc_deque_size(dq) == 2000 - 666);
+    for (size_t i=0; i < sakuc_deque_size(dq); i++)
+        sakuc_assert(*(int *)sakuc_deque_at(dq, i) == (int) i - 1000 + 333);
+    
+    // ## test part 5.3 - oscillating queue, the map does not keep growing.
+    for (int i=0; i < 100000; i++) {
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0);
+    }
+    sakuc_assert(dq->map_size <= 4 * dq->num_sub_deque + 8);
+    sakuc_assert(*(int *)sakuc_deque_at(dq, sakuc_deque_size(dq) - 1) == 99999);
+    sakuc_deque_destroy(dq);
+    
+    // ============================== part 6 ==============================
+    // ## test part 6.1 - oscillating around a block boundary hits the pool.
+    sakuc_deque_pool_t *pool = sakuc_deque_pool_new(8, sizeof(int), 2, 4);
+    sakuc_assert(pool);
+    sakuc_assert(sakuc_deque_new_with_pool(16, sizeof(int), 0, pool) == nullptr); // geometry.
+    dq = sakuc_deque_new_with_pool(8, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY, pool);
+    sakuc_assert(dq && pool->misses == 1);
+    
+    for (int i=0; i < 8; i++)
+        sakuc_deque_push_back(dq, &i, sizeof(int));
+    for (int i=0; i < 1000; i++) {
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0);
+    }
+    sakuc_assert(pool->misses <= 3 && pool->hits > 100 && pool->released == 0);
+    
+    // ## test part 6.2 - blocks above the high watermark are released down to the low one.
+    for (int i=0; i < 8 * 10; i++)
+        sakuc_deque_push_back(dq, &i, sizeof(int));
+    size_t misses = pool->misses;
+    while (sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0)
+        ;
+    sakuc_deque_sweep(dq, SAKUC_DEQUE_SWEEP_MANUALLY);
+    sakuc_assert(pool->num_free >= pool->low_watermark && pool->num_free <= pool->high_watermark);
+    sakuc_assert(pool->released > 0 && pool->released + pool->num_free + dq->num_sub_deque
+                                       == pool->misses);
+    
+    // ## test part 6.3 - another deque shares the pool, no more malloc.
+    sakuc_deque_t *dq2 = sakuc_deque_new_with_pool(8, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY, pool);
+    sakuc_assert(dq2 && pool->misses == misses);
+    sakuc_deque_destroy(dq2);
+    sakuc_deque_destroy(dq);
+    sakuc_assert(pool->num_free <= pool->high_watermark);
+    sakuc_assert(sakuc_deque_pool_destroy(pool) == 0);
+    
+    // ============================== part 7 ==============================
+    // ## test part 7.1 - blocks are single cache-line-aligned allocations.
+    dq = sakuc_deque_new(5, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY);
+    for (int i=0; i < 20; i++)
+        sakuc_deque_push_back(dq, &i, sizeof(int));
+    for (size_t i=0; i < dq->num_sub_deque; i++)
+        sakuc_assert((uintptr_t) dq->map[dq->map_first + i] % SAKUC_CACHE_LINE_SIZE == 0);
+    sakuc_assert(*(int *)sakuc_deque_at(dq, 13) == 13);
+    sakuc_deque_destroy(dq);
+    
+    // ## test part 7.2 - page-sized blocks.
+    dq = sakuc_deque_new(100, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY | SAKUC_DEQUE_PAGE_BLOCKS);
+    sakuc_assert(dq && dq->sub_deque_size > 100);
+    sakuc_assert(sakuc_sub_deque_bytes(dq->sub_deque_size, sizeof(int)) <= SAKUC_PAGE_SIZE
+                 && sakuc_sub_deque_bytes(dq->sub_deque_size + 1, sizeof(int)) > SAKUC_PAGE_SIZE);
+    for (int i=0; i < 10000; i++) {
+        int neg = -1 - i;
+        sakuc_deque_push_back(dq, &i, sizeof(int));
+        sakuc_deque_push_front(dq, &neg, sizeof(int));
+    }
+    for (size_t i=0; i < dq->num_sub_deque; i++)
+        sakuc_assert((uintptr_t) dq->map[dq->map_first + i] % SAKUC_PAGE_SIZE == 0
+                     && dq->map[dq->map_first + i]->page_aligned);
+    for (int i=0; i < 20000; i++)
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i - 10000);
+    // the last freed block is kept for the next one, until shrunk.
+    sakuc_assert(dq->spare && dq->spare->page_aligned);
+    sakuc_assert(sakuc_deque_shrink_to_fit(dq) == 0 && dq->spare == nullptr);
+    sakuc_deque_destroy(dq);
+    
+    // ## test part 7.3 - page-aligned and cache-line-aligned blocks sharing a pool.
+    dq = sakuc_deque_new(100, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY | SAKUC_DEQUE_PAGE_BLOCKS);
+    sakuc_assert(dq);
+    size_t page_block_size = dq->sub_deque_size;
+    sakuc_deque_destroy(dq);
+    pool = sakuc_deque_pool_new(page_block_size, sizeof(int), 2, 4);
+    sakuc_assert(pool);
+    dq = sakuc_deque_new_with_pool(100, sizeof(int),
+                                   SAKUC_DEQUE_SWEEP_IMMEDIATELY | SAKUC_DEQUE_PAGE_BLOCKS, pool);
+    dq2 = sakuc_deque_new_with_pool(page_block_size, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY,
+                                    pool);
+    sakuc_assert(dq && dq2);
+    for (int round=0; round < 4; round++) {
+        sakuc_deque_t *from = (round % 2) ? dq2 : dq;
+        for (int i=0; i < 5000; i++)
+            sakuc_assert(sakuc_deque_push_back(from, &i, sizeof(int)) == 0);
+        for (int i=0; i < 5000; i++)
+            sakuc_assert(sakuc_deque_pop_front(from, &value, sizeof(int)) == 0 && value == i);
+    }
+    sakuc_deque_destroy(dq);
+    sakuc_deque_destroy(dq2);
+    sakuc_assert(sakuc_deque_pool_destroy(pool) == 0);
+    
+    // ============================== part 8 ==============================
+    // ## test part 8.1 - bulk push/pop across blocks, mixed with single ones.
+    static int values[1000];
+    for (int i=0; i < 1000; i++)
+        values[i] = i;
+    dq = sakuc_deque_new(7, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY);
+    sakuc_assert(sakuc_deque_peek_front(dq) == nullptr && sakuc_deque_peek_back(dq) == nullptr);
+    sakuc_assert(sakuc_deque_push_back_n(dq, values, 3, sizeof(int)) == 3);
+    value = -1;
+    sakuc_assert(sakuc_deque_push_front(dq, &value, sizeof(int)) == 0);
+    sakuc_assert(sakuc_deque_push_back_n(dq, values + 3, 997, sizeof(int)) == 997);
+    sakuc_assert(sakuc_deque_size(dq) == 1001);
+    sakuc_assert(*(int *)sakuc_deque_peek_front(dq) == -1 && *(int *)sakuc_deque_peek_back(dq) == 999);
+    
+    // ## test part 8.2 - block iterators read everything in place, in order.
+    struct sakuc_deque_iter it;
+    void *elems;
+    size_t count, total = 0;
+    int in_order = TRUE;
+    sakuc_deque_iter_init(dq, &it);
+    while ((count = sakuc_deque_iter_next(&it, &elems)) > 0) {
+        sakuc_assert(count <= dq->sub_deque_size);
+        for (size_t i=0; i < count; i++)
+            in_order = in_order && ((int *)elems)[i] == (int) total + (int) i - 1;
+        total += count;
+    }
+    sakuc_assert(in_order && total == 1001);
+    
+    int out[600];
+    sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == -1);
+    sakuc_assert(sakuc_deque_pop_front_n(dq, out, 600, sizeof(int)) == 600);
+    for (int i=0; i < 600; i++)
+        sakuc_assert(out[i] == i);
+    sakuc_assert(*(int *)sakuc_deque_peek_front(dq) == 600);
+    
+    // the head block emptied to its end, the iterator skips it.
+    sakuc_assert(sakuc_deque_pop_front_n(dq, out, 4, sizeof(int)) == 4);
+    sakuc_deque_iter_init(dq, &it);
+    sakuc_assert(sakuc_deque_iter_next(&it, &elems) > 0 && *(int *)elems == 604);
+    
+    sakuc_assert(sakuc_deque_pop_front_n(dq, out, 600, sizeof(int)) == 396 && out[395] == 999);
+    sakuc_assert(sakuc_deque_size(dq) == 0 && sakuc_deque_pop_front_n(dq, out, 1, sizeof(int)) == 0);
+    sakuc_deque_iter_init(dq, &it);
+    sakuc_assert(sakuc_deque_iter_next(&it, &elems) == 0);
+    sakuc_deque_destroy(dq);
+    
+    // ============================== part 9 ==============================
+    // ## test part 9.1 - deque on the stack, its first block in caller storage.
+    struct sakuc_deque stack_dq;
+    char storage[SAKUC_DEQUE_INLINE_STORAGE_SIZE(16, sizeof(int))];
+    sakuc_assert(sakuc_deque_init(&stack_dq, 16, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY,
+                                  storage, sizeof(storage) - SAKUC_CACHE_LINE_SIZE) == -1);
+    sakuc_assert(sakuc_deque_init(&stack_dq, 16, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY,
+                                  storage, sizeof(storage)) == 0);
+    dq = &stack_dq;
+    sakuc_assert(dq->dq_head == dq->inline_block && dq->map == dq->map_inline);
+    sakuc_assert((char *) dq->inline_block >= storage
+                 && (uintptr_t) dq->inline_block % SAKUC_CACHE_LINE_SIZE == 0);
+    
+    for (int i=0; i < 16; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    sakuc_assert(dq->num_sub_deque == 1);
+    
+    // ## test part 9.2 - overflow goes to heap blocks, the inline one is reused once free.
+    for (int i=16; i < 100; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    sakuc_assert(dq->num_sub_deque == 7 && dq->map != dq->map_inline);
+    for (int i=0; i < 90; i++)
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i);
+    sakuc_assert(!dq->inline_block_used);
+    for (int i=100; i < 150; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    sakuc_assert(dq->inline_block_used && *(int *)sakuc_deque_at(dq, 59) == 149);
+    for (int i=90; i < 150; i++)
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i);
+    sakuc_assert(sakuc_deque_destroy(dq) == 0);
+    
+    // ## test part 9.3 - no storage, or a heap deque: the map is inline until it grows.
+    sakuc_assert(sakuc_deque_init(&stack_dq, 16, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY,
+                                  nullptr, 0) == 0);
+    sakuc_assert(stack_dq.inline_block == nullptr && sakuc_deque_push_back(&stack_dq, &value, sizeof(int)) == 0);
+    sakuc_assert(sakuc_deque_destroy(&stack_dq) == 0);
+    dq = sakuc_deque_new(16, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY);
+    sakuc_assert(dq && dq->owned && dq->map == dq->map_inline);
+    sakuc_deque_destroy(dq);
+    
+    // ============================== part 10 ==============================
+    // ## test part 10.1 - blocks grow with the deque, up to the limit.
+    struct sakuc_deque_memory mem;
+    sakuc_assert(sakuc_deque_new_growing(64, 32, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY) == nullptr);
+    dq = sakuc_deque_new_growing(4, 256, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY);
+    sakuc_assert(dq);
+    for (int i=0; i < 5000; i++) {
+        int neg = -1 - i / 4;
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+        if (i % 4 == 0)
+            sakuc_assert(sakuc_deque_push_front(dq, &neg, sizeof(int)) == 0);
+    }
+    sakuc_assert(dq->dq_head->size == 256 && dq->dq_tail->size == 256);
+    sakuc_assert(dq->num_sub_deque < 6250 / 128);
+    sakuc_assert(sakuc_deque_memory(dq, &mem) == mem.total_bytes && mem.num_blocks == dq->num_sub_deque);
+    sakuc_assert(mem.capacity >= 6250 && mem.used_bytes == 6250 * sizeof(int) && mem.map_bytes > 0);
+    
+    // ## test part 10.2 - random access across blocks of different sizes.
+    for (int i=0; i < 6250; i++)
+        sakuc_assert(*(int *)sakuc_deque_at(dq, (size_t) i) == i - 1250);
+    sakuc_assert(sakuc_deque_at(dq, 6250) == nullptr);
+    
+    // ## test part 10.3 - shrink to fit after draining, memory goes down.
+    size_t before = mem.total_bytes;
+    for (int i=0; i < 6200; i++)
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i - 1250);
+    sakuc_assert(sakuc_deque_shrink_to_fit(dq) == 0);
+    sakuc_assert(dq->num_sub_deque == 1 && dq->dq_head->size == 50 && dq->map == dq->map_inline);
+    sakuc_assert(sakuc_deque_memory(dq, &mem) < before / 20 && mem.capacity == 50);
+    for (int i=0; i < 50; i++)
+        sakuc_assert(*(int *)sakuc_deque_at(dq, (size_t) i) == 4950 + i);
+    value = -2;
+    sakuc_assert(sakuc_deque_push_front(dq, &value, sizeof(int)) == 0);
+    sakuc_assert(sakuc_deque_push_back(dq, &value, sizeof(int)) == 0);
+    sakuc_assert(sakuc_deque_size(dq) == 52 && *(int *)sakuc_deque_at(dq, 1) == 4950);
+    sakuc_assert(*(int *)sakuc_deque_at(dq, 50) == 4999 && *(int *)sakuc_deque_at(dq, 51) == -2);
+    sakuc_deque_destroy(dq);
+    
+    // ## test part 10.4 - fixed size blocks: compacted, still O(1) random access.
+    dq = sakuc_deque_new(8, sizeof(int), SAKUC_DEQUE_SWEEP_MANUALLY);
+    for (int i=0; i < 100; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    for (int i=0; i < 60; i++)
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0);
+    sakuc_assert(dq->num_sub_deque == 13 && sakuc_deque_shrink_to_fit(dq) == 0);
+    sakuc_assert(dq->num_sub_deque == 5 && sakuc_deque_memory(dq, &mem) > 0 && mem.capacity == 40);
+    for (int i=0; i < 40; i++)
+        sakuc_assert(*(int *)sakuc_deque_at(dq, (size_t) i) == 60 + i);
+    sakuc_assert(sakuc_deque_shrink_to_fit(dq) == 0 && dq->num_sub_deque == 5);
+    for (int i=0; i < 40; i++)
+        sakuc_assert(sakuc_deque_pop_back(dq, &value, sizeof(int)) == 0 && value == 99 - i);
+    sakuc_assert(sakuc_deque_shrink_to_fit(dq) == 0 && dq->num_sub_deque == 1);
+    sakuc_deque_destroy(dq);
+    
+    // ============================== part 11 ==============================
+    // ## test part 11.1 - a spilling deque stays within its budget (plus hot blocks).
+    size_t block_bytes = sakuc_sub_deque_bytes(64, sizeof(int));
+    sakuc_assert(sakuc_deque_new_spilling(64, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY,
+                                          8 * block_bytes, "/nonexistent") == nullptr);
+    dq = sakuc_deque_new_spilling(64, sizeof(int), SAKUC_DEQUE_SWEEP_IMMEDIATELY,
+                                  8 * block_bytes, nullptr);
+    sakuc_assert(dq);
+    for (int i=0; i < 20000; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    sakuc_deque_memory(dq, &mem);
+    sakuc_assert(mem.num_blocks == dq->num_sub_deque && mem.num_spilled > 250);
+    sakuc_assert(mem.spilled_bytes == mem.num_spilled * 64 * sizeof(int));
+    sakuc_assert(mem.block_bytes - mem.num_spilled * sizeof(struct sakuc_sub_deque_)
+                 <= (8 + SAKUC_DEQUE_SPILL_READ_AHEAD + 2) * block_bytes);
+    
+    // ## test part 11.2 - random access reads a spilled block back.
+    sakuc_assert(*(int *)sakuc_deque_at(dq, 10000) == 10000 && *(int *)sakuc_deque_at(dq, 19999) == 19999);
+    sakuc_assert(dq->map[dq->map_head + 10000 / 64]->spill_slot == SAKUC_SUB_DEQUE_RESIDENT);
+    
+    // ## test part 11.3 - both ends, then drain in order, the file is emptied.
+    value = -1;
+    sakuc_assert(sakuc_deque_push_front(dq, &value, sizeof(int)) == 0);
+    for (int i=19999; i >= 19000; i--)
+        sakuc_assert(sakuc_deque_pop_back(dq, &value, sizeof(int)) == 0 && value == i);
+    for (int i=19000; i < 25000; i++)
+        sakuc_assert(sakuc_deque_push_back(dq, &i, sizeof(int)) == 0);
+    sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == -1);
+    for (int i=0; i < 25000; i++) {
+        sakuc_assert(sakuc_deque_pop_front(dq, &value, sizeof(int)) == 0 && value == i);
+        if (i % 1000 == 0) {
+            sakuc_deque_memory(dq, &mem);
+            sakuc_assert(mem.block_bytes - mem.num_spilled * sizeof(struct sakuc_sub_deque_)
+                         <= (8 + SAKUC_DEQUE_SPILL_READ_AHEAD + 2) * block_bytes);
+        }
+    }
+    sakuc_assert(sakuc_deque_size(dq) == 0 && sakuc_deque_pop_front(dq, &value, sizeof(int)) == -1);
+    sakuc_assert(sakuc_deque_memory(dq, &mem) > 0 && mem.num_spilled == 0);
+    sakuc_assert(sakuc_deque_destroy(dq) == 0);
+    
     return 0;
 sakuc_assert_failed:
     return -1;
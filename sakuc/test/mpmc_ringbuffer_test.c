@@ -0,0 +1,124 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../src/mpmc_ringbuffer.h"
+#include "../src/common_atomic_defs.h"
+#include "common_test_defs.h"
+#include "mpmc_ringbuffer_test.h"
+
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+#define NUM_MESSAGES_PER_PRODUCER 50000
+
+struct message {
+    size_t producer;
+    size_t seq;
+};
+
+struct thread_ctx {
+    mpmc_ringbuffer_t *rb;
+    size_t id;
+    // consumer only - the next @seq expected from each producer is > last one.
+    size_t next_seq[NUM_PRODUCERS];
+    size_t received;
+    int in_order;
+};
+
+static size_t num_consumed = 0;
+
+static void *producer_thread(void *arg)
+{
+    struct thread_ctx *ctx = arg;
+    struct message msg = { .producer = ctx->id };
+    for (msg.seq = 0; msg.seq < NUM_MESSAGES_PER_PRODUCER; msg.seq++) {
+        while (mpmc_rbuf_push_back(ctx->rb, &msg, sizeof(msg)) == -1)
+            sched_yield();
+    }
+    return nullptr;
+}
+
+static void *consumer_thread(void *arg)
+{
+    struct thread_ctx *ctx = arg;
+    struct message msg;
+    while (osal_atomic_load_relaxed(&num_consumed) < NUM_PRODUCERS * NUM_MESSAGES_PER_PRODUCER) {
+        if (mpmc_rbuf_pop_front(ctx->rb, &msg, sizeof(msg)) == nullptr) {
+            sched_yield();
+            continue;
+        }
+        osal_atomic_fetch_add(&num_consumed, 1);
+        
+        // FIFO: messages of the same producer are seen in order by any consumer.
+        if (msg.producer >= NUM_PRODUCERS || msg.seq < ctx->next_seq[msg.producer])
+            ctx->in_order = FALSE;
+        else
+            ctx->next_seq[msg.producer] = msg.seq + 1;
+        ++ ctx->received;
+    }
+    return nullptr;
+}
+
+int test_mpmc_ringbuffer(void)
+{
+    // ## test part 1 - single thread, capacity rounded up to power of 2.
+    mpmc_ringbuffer_t *rb = mpmc_rbuf_new(100, sizeof(size_t));
+    sakuc_assert(rb && rb->capacity == 128);
+    
+    size_t i = 0;
+    for (; i < 200; i++) {
+        if (mpmc_rbuf_push_back(rb, &i, sizeof(size_t)) == -1)
+            break;
+    }
+    sakuc_assert(i == 128 && mpmc_rbuf_length(rb) == 128);
+    
+    // ## test part 2 - FIFO order over several laps.
+    size_t value = 0;
+    size_t count = 0;
+    for (size_t lap = 0; lap < 3; lap++) {
+        while (mpmc_rbuf_pop_front(rb, &value, sizeof(size_t)) != nullptr) {
+            if (value == count)
+                ++count;
+            else
+                break;
+        }
+        for (i = count; i < count + 128; i++)
+            sakuc_assert(mpmc_rbuf_push_back(rb, &i, sizeof(size_t)) == 0);
+    }
+    sakuc_assert(count == 3 * 128 && mpmc_rbuf_length(rb) == 128);
+    sakuc_assert(mpmc_rbuf_pop_front(rb, &value, sizeof(char)) == nullptr);
+    sakuc_assert(mpmc_rbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - several producer threads and consumer threads.
+    rb = mpmc_rbuf_new(64, sizeof(struct message));
+    sakuc_assert(rb);
+    
+    struct thread_ctx producers[NUM_PRODUCERS];
+    struct thread_ctx consumers[NUM_CONSUMERS];
+    pthread_t threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    num_consumed = 0;
+    
+    for (i = 0; i < NUM_CONSUMERS; i++) {
+        consumers[i] = (struct thread_ctx) { .rb = rb, .id = i, .in_order = TRUE };
+        sakuc_assert(pthread_create(&threads[i], nullptr, consumer_thread, &consumers[i]) == 0);
+    }
+    for (i = 0; i < NUM_PRODUCERS; i++) {
+        producers[i] = (struct thread_ctx) { .rb = rb, .id = i };
+        sakuc_assert(pthread_create(&threads[NUM_CONSUMERS + i], nullptr,
+                                    producer_thread, &producers[i]) == 0);
+    }
+    for (i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++)
+        pthread_join(threads[i], nullptr);
+    
+    count = 0;
+    for (i = 0; i < NUM_CONSUMERS; i++) {
+        sakuc_assert(consumers[i].in_order);
+        count += consumers[i].received;
+    }
+    sakuc_assert(count == NUM_PRODUCERS * NUM_MESSAGES_PER_PRODUCER
+                 && mpmc_rbuf_length(rb) == 0);
+    sakuc_assert(mpmc_rbuf_destroy(rb) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef MPMC_RINGBUFFER_TEST_H_
+#define MPMC_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_mpmc_ringbuffer(void);
+
+#endif // MPMC_RINGBUFFER_TEST_H_
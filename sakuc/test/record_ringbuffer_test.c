@@ -0,0 +1,118 @@
+#include <string.h>
+#include "../src/record_ringbuffer.h"
+#include "common_test_defs.h"
+#include "record_ringbuffer_test.h"
+
+/* record @i is @i+1 bytes of value @i. */
+static int push_record(record_ringbuffer_t *rb, size_t i)
+{
+    unsigned char data[64];
+    memset(data, (int) (i & 0xff), i + 1);
+    return recbuf_push_back(rb, data, i + 1);
+}
+
+static int check_record(const void *data, size_t len, size_t i)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    if (len != i + 1)
+        return -1;
+    for (size_t j=0; j < len; j++)
+        if (p[j] != (i & 0xff))
+            return -1;
+    return 0;
+}
+
+int test_record_ringbuffer(void)
+{
+    unsigned char buf[64];
+    size_t len;
+    
+    // ## test part 1 - capacity rounded up to power of 2, FIFO order with variable lengths.
+    record_ringbuffer_t *rb = recbuf_new(1000, RBUF_OVERFLOW_REJECT);
+    sakuc_assert(rb && rb->capacity == 1024);
+    sakuc_assert(recbuf_push_back(rb, buf, 1024) == -1);  // can never fit.
+    
+    size_t pushed = 0;
+    while (push_record(rb, pushed % 40) == 0)
+        ++pushed;
+    sakuc_assert(pushed > 0 && recbuf_length(rb) == pushed && recbuf_bytes(rb) <= 1024);
+    
+    for (size_t i=0; i < pushed; i++) {
+        len = sizeof(buf);
+        sakuc_assert(recbuf_pop_front(rb, buf, &len) == buf);
+        sakuc_assert(check_record(buf, len, i % 40) == 0);
+    }
+    len = sizeof(buf);
+    sakuc_assert(recbuf_pop_front(rb, buf, &len) == nullptr);
+    sakuc_assert(recbuf_length(rb) == 0 && recbuf_bytes(rb) == 0);
+    
+    // ## test part 2 - buffer too small leaves the record in place.
+    sakuc_assert(push_record(rb, 19) == 0);
+    len = 4;
+    sakuc_assert(recbuf_pop_front(rb, buf, &len) == nullptr && len == 20);
+    sakuc_assert(recbuf_length(rb) == 1);
+    sakuc_assert(recbuf_pop_front(rb, buf, &len) == buf && check_record(buf, len, 19) == 0);
+    
+    // zero length records are fine.
+    sakuc_assert(recbuf_push_back(rb, nullptr, 0) == 0);
+    len = 0;
+    sakuc_assert(recbuf_pop_front(rb, buf, &len) == buf && len == 0);
+    sakuc_assert(recbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - wrap around with skip markers, records are never split.
+    rb = recbuf_new(256, RBUF_OVERFLOW_REJECT);
+    sakuc_assert(rb);
+    size_t next_push = 0, next_pop = 0;
+    for (int round=0; round < 1000; round++) {
+        while (push_record(rb, next_push % 50) == 0)
+            ++next_push;
+        
+        struct recbuf_record records[3];
+        size_t n = recbuf_peek_batch(rb, records, 3);
+        sakuc_assert(n > 0 && n <= 3);
+        for (size_t i=0; i < n; i++) {
+            const char *begin = (const char *) rb->buffer;
+            const char *data = (const char *) records[i].data;
+            sakuc_assert(data > begin && data + records[i].len <= begin + rb->capacity);
+            sakuc_assert(check_record(data, records[i].len, (next_pop + i) % 50) == 0);
+        }
+        sakuc_assert(recbuf_consume(rb, n) == 0);
+        next_pop += n;
+    }
+    sakuc_assert(recbuf_length(rb) == next_push - next_pop);
+    sakuc_assert(recbuf_consume(rb, recbuf_length(rb) + 1) == -1);
+    sakuc_assert(recbuf_consume(rb, recbuf_length(rb)) == 0 && recbuf_bytes(rb) == 0);
+    sakuc_assert(recbuf_destroy(rb) != -1);
+    
+    // ## test part 4 - overwrite drops the oldest records, like ringbuffer_t.
+    rb = recbuf_new(256, RBUF_OVERFLOW_OVERWRITE);
+    sakuc_assert(rb);
+    for (size_t i=0; i < 500; i++)
+        sakuc_assert(push_record(rb, i % 30) == 0);
+    
+    size_t count = recbuf_length(rb);
+    sakuc_assert(count > 0 && count < 500);
+    for (size_t i=500 - count; i < 500; i++) {
+        len = sizeof(buf);
+        sakuc_assert(recbuf_pop_front(rb, buf, &len) == buf);
+        sakuc_assert(check_record(buf, len, i % 30) == 0);
+    }
+    sakuc_assert(recbuf_length(rb) == 0);
+    
+    // a record as large as the whole buffer, dropping everything else.
+    push_record(rb, 3);
+    unsigned char big[256 - 8];
+    memset(big, 7, sizeof(big));
+    sakuc_assert(recbuf_push_back(rb, big, sizeof(big)) == 0 && recbuf_length(rb) == 1);
+    struct recbuf_record record;
+    sakuc_assert(recbuf_peek_batch(rb, &record, 1) == 1 && record.len == sizeof(big));
+    sakuc_assert(memcmp(record.data, big, sizeof(big)) == 0);
+    sakuc_assert(recbuf_destroy(rb) != -1);
+    
+    sakuc_assert(recbuf_new(1000, RBUF_OVERFLOW_BLOCK) == nullptr);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
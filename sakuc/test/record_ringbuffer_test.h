@@ -0,0 +1,7 @@
+#ifndef RECORD_RINGBUFFER_TEST_H_
+#define RECORD_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_record_ringbuffer(void);
+
+#endif // RECORD_RINGBUFFER_TEST_H_
@@ -1,3 +1,9 @@
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <string.h>
 #include "../src/ringbuffer.h"
 #include "common_test_defs.h"
 #include "ringbuffer_test.h"
@@ -17,6 +23,42 @@ static const char *model_list[] = {
 
 static const int model_list_length = sizeof(model_list) / sizeof(model_list[0]);
 
+#define NUM_BLOCKING_MESSAGES 20000
+
+static void *blocking_producer(void *arg)
+{
+    ringbuffer_t *rb = arg;
+    for (int i=0; i < NUM_BLOCKING_MESSAGES; i++) {
+        if (i % 2)
+            rbuf_push_back(rb, &i, sizeof(int)); // waits for room.
+        else
+            while (rbuf_push_back_timed(rb, &i, sizeof(int), 1) == -1)
+                ;
+    }
+    return nullptr;
+}
+
+static void *one_blocked_push(void *arg)
+{
+    ringbuffer_t *rb = arg;
+    int value = NUM_BLOCKING_MESSAGES;
+    rbuf_push_back(rb, &value, sizeof(int)); // waits for room.
+    return nullptr;
+}
+
+struct fd_reader {
+    ringbuffer_t *rb;
+    int fd;
+    ssize_t ret;
+};
+
+static void *blocked_read_fd(void *arg)
+{
+    struct fd_reader *reader = arg;
+    reader->ret = rbuf_read_fd(reader->rb, reader->fd); // waits for data.
+    return nullptr;
+}
+
 int test_ringbuffer (void)
 {
     // ## test part 1
@@ -63,6 +105,266 @@ int test_ringbuffer (void)
     
     sakuc_assert (rbuf_destroy(rbuf) != -1);
     
+    // ## test part 5 - batch push without overwrite, across the wrap point.
+    int values[250];
+    rbuf = rbuf_new(100, sizeof(int));
+    for (int i=0; i < 250; i++)
+        values[i] = i;
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 70, sizeof(int), FALSE) == 70);
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 50, sizeof(int)) == 50
+                  && values[0] == 0 && values[49] == 49);
+    for (int i=0; i < 250; i++)
+        values[i] = 1000 + i;
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 250, sizeof(int), FALSE) == 80);
+    sakuc_assert (rbuf_length(rbuf) == 100
+                  && rbuf_push_back_n(rbuf, values, 1, sizeof(int), FALSE) == 0);
+    
+    // ## test part 6 - batch pop across the wrap point.
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 250, sizeof(int)) == 100
+                  && rbuf_length(rbuf) == 0);
+    for (count=0; count < 100; count++) {
+        if (values[count] != (count < 20 ? 50 + count : 1000 + count - 20))
+            break;
+    }
+    sakuc_assert (count == 100 && rbuf_pop_front_n(rbuf, values, 1, sizeof(int)) == 0);
+    
+    // ## test part 7 - batch push with overwrite, same as rbuf_push_back one-by-one.
+    for (int i=0; i < 250; i++)
+        values[i] = i;
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 30, sizeof(int), TRUE) == 30);
+    sakuc_assert (rbuf_push_back_n(rbuf, values + 30, 90, sizeof(int), TRUE) == 90
+                  && rbuf_length(rbuf) == 100);
+    sakuc_assert (rbuf_push_back_n(rbuf, values + 120, 130, sizeof(int), TRUE) == 130
+                  && rbuf_length(rbuf) == 100);
+    count = 150;
+    int value;
+    while (rbuf_pop_front(rbuf, &value, sizeof(int)) != nullptr) {
+        if (value == count)
+            ++count;
+        else
+            break;
+    }
+    sakuc_assert (count == 250);
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 1, sizeof(char), TRUE) == 0);
+    
+    // ## test part 8 - zero-copy reserve/commit across the wrap point.
+    struct rbuf_region regions[2];
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 60, sizeof(int), FALSE) == 60
+                  && rbuf_pop_front_n(rbuf, values, 60, sizeof(int)) == 60);
+    sakuc_assert (rbuf_reserve_back(rbuf, 70, regions) == 70
+                  && regions[0].count == 40 && regions[1].count == 30
+                  && regions[1].data == rbuf->buffer);
+    for (int r=0, i=0; r < 2; r++) {
+        for (size_t j=0; j < regions[r].count; j++)
+            ((int *)regions[r].data)[j] = i++;
+    }
+    sakuc_assert (rbuf_length(rbuf) == 0);
+    sakuc_assert (rbuf_commit_back(rbuf, 70) == 0 && rbuf_length(rbuf) == 70);
+    sakuc_assert (rbuf_reserve_back(rbuf, 100, regions) == 30
+                  && regions[0].count == 30 && regions[1].count == 0);
+    sakuc_assert (rbuf_commit_back(rbuf, 31) == -1);
+    
+    // ## test part 9 - zero-copy peek/consume.
+    sakuc_assert (rbuf_peek_front(rbuf, 100, regions) == 70
+                  && regions[0].count == 40 && regions[1].count == 30);
+    for (int r=0, i=0; r < 2; r++) {
+        for (size_t j=0; j < regions[r].count; j++, i++) {
+            if (((int *)regions[r].data)[j] != i)
+                count = -1;
+        }
+    }
+    sakuc_assert (count != -1 && rbuf_length(rbuf) == 70);
+    sakuc_assert (rbuf_consume_front(rbuf, 71) == -1);
+    sakuc_assert (rbuf_consume_front(rbuf, 50) == 0 && rbuf_length(rbuf) == 20);
+    sakuc_assert (rbuf_pop_front(rbuf, &value, sizeof(int)) && value == 50);
+    
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    
+    // ## test part 10 - reject policy, never overwrites.
+    rbuf = rbuf_new_with_policy(10, sizeof(int), RBUF_OVERFLOW_REJECT);
+    sakuc_assert (rbuf && rbuf->sync == nullptr);
+    for (count=0; count < 20; count++) {
+        if (rbuf_push_back(rbuf, &count, sizeof(int)) == -1)
+            break;
+    }
+    sakuc_assert (count == 10 && rbuf_pop_front(rbuf, &value, sizeof(int)) && value == 0);
+    sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0
+                  && rbuf_push_back(rbuf, &count, sizeof(int)) == -1);
+    // nor by batch, even if asked to.
+    sakuc_assert (rbuf_pop_front(rbuf, &value, sizeof(int)) && value == 1);
+    sakuc_assert (rbuf_push_back_n(rbuf, values, 5, sizeof(int), TRUE) == 1
+                  && rbuf_push_back_n(rbuf, values, 5, sizeof(int), TRUE) == 0);
+    sakuc_assert (rbuf_pop_front(rbuf, &value, sizeof(int)) && value == 2);
+    sakuc_assert (rbuf_set_wakeup_batch(rbuf, 1) == -1 && rbuf_eventfd(rbuf) == -1);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    sakuc_assert (rbuf_new_with_policy(10, sizeof(int), 42) == nullptr);
+    
+    // ## test part 11 - block policy: timeout, eventfd, wakeup batch.
+    rbuf = rbuf_new_with_policy(16, sizeof(int), RBUF_OVERFLOW_BLOCK);
+    sakuc_assert (rbuf && rbuf->sync);
+    sakuc_assert (rbuf_pop_front_timed(rbuf, &value, sizeof(int), 10) == nullptr);
+    
+#ifdef __linux__
+    int efd = rbuf_eventfd(rbuf);
+    uint64_t events = 0;
+    sakuc_assert (efd >= 0 && read(efd, &events, sizeof(events)) == -1);
+    sakuc_assert (rbuf_set_wakeup_batch(rbuf, 4) == 0);
+    for (count=0; count < 3; count++)
+        sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0);
+    sakuc_assert (read(efd, &events, sizeof(events)) == -1);
+    sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0);
+    sakuc_assert (read(efd, &events, sizeof(events)) == sizeof(events) && events == 1);
+    // after a timeout, whatever is there is popped even below the batch.
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 2, sizeof(int)) == 2);
+    sakuc_assert (rbuf_pop_front_n_timed(rbuf, values, 10, sizeof(int), 10) == 2
+                  && values[0] == 2 && values[1] == 3);
+    
+    // a bounded pop leaving a batch behind makes the eventfd readable again.
+    struct pollfd pfd = { .fd = efd, .events = POLLIN };
+    for (count=0; count < 8; count++)
+        sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0);
+    sakuc_assert (read(efd, &events, sizeof(events)) == sizeof(events));
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 2, sizeof(int)) == 2);
+    sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0);
+    sakuc_assert (poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN));
+    sakuc_assert (read(efd, &events, sizeof(events)) == sizeof(events));
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 7, sizeof(int)) == 7);
+    sakuc_assert (poll(&pfd, 1, 0) == 0);
+    sakuc_assert (rbuf_set_wakeup_batch(rbuf, 1) == 0);
+#endif
+    
+    for (count=0; count < 16; count++)
+        sakuc_assert (rbuf_push_back(rbuf, &count, sizeof(int)) == 0);
+    sakuc_assert (rbuf_push_back_timed(rbuf, &count, sizeof(int), 10) == -1);
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 16, sizeof(int)) == 16);
+    
+    // ## test part 12 - block policy: a producer thread never loses data.
+    pthread_t producer;
+    sakuc_assert (pthread_create(&producer, nullptr, blocking_producer, rbuf) == 0);
+    int in_order = TRUE;
+    for (count=0; count < NUM_BLOCKING_MESSAGES; ) {
+        if (count % 3) {
+            if (rbuf_pop_front_timed(rbuf, &value, sizeof(int), -1) == nullptr)
+                continue;
+            in_order = in_order && value == count;
+            ++count;
+        }
+        else {
+            size_t n = rbuf_pop_front_n_timed(rbuf, values, 5, sizeof(int), 100);
+            for (size_t i=0; i < n; i++)
+                in_order = in_order && values[i] == count + (int) i;
+            count += n;
+        }
+    }
+    pthread_join(producer, nullptr);
+    sakuc_assert (in_order && rbuf_length(rbuf) == 0);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    
+    // ## test part 12.1 - block policy: freeing several slots wakes every blocked producer.
+    pthread_t producers[3];
+    rbuf = rbuf_new_with_policy(4, sizeof(int), RBUF_OVERFLOW_BLOCK);
+    sakuc_assert (rbuf && rbuf_push_back_n(rbuf, values, 4, sizeof(int), FALSE) == 4);
+    for (int i=0; i < 3; i++)
+        sakuc_assert (pthread_create(&producers[i], nullptr, one_blocked_push, rbuf) == 0);
+    // still full after 50ms, meanwhile the producers block.
+    sakuc_assert (rbuf_push_back_timed(rbuf, values, sizeof(int), 50) == -1);
+    sakuc_assert (rbuf_set_wakeup_batch(rbuf, 3) == 0);
+    sakuc_assert (rbuf_pop_front_n(rbuf, values, 4, sizeof(int)) == 4);
+    // only the wakeups passed on by the producers bring the 3 elements in time.
+    sakuc_assert (rbuf_pop_front_n_timed(rbuf, values, 4, sizeof(int), 5000) == 3);
+    for (int i=0; i < 3; i++)
+        pthread_join(producers[i], nullptr);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    
+#ifdef __linux__
+    // ## test part 13 - mirrored ringbuffer, wrap-free regions.
+    static const char text[] = "a record which crosses the end of the buffer";
+    char bytes[sizeof(text)];
+    rbuf = rbuf_new_mirrored(100, sizeof(char), RBUF_OVERFLOW_REJECT);
+    sakuc_assert (rbuf && rbuf->mirrored && rbuf->capacity >= 100
+                  && rbuf->capacity % sysconf(_SC_PAGESIZE) == 0);
+    sakuc_assert (rbuf_reserve_back(rbuf, rbuf->capacity - 10, regions) == rbuf->capacity - 10
+                  && rbuf_commit_back(rbuf, rbuf->capacity - 10) == 0
+                  && rbuf_consume_front(rbuf, rbuf->capacity - 10) == 0);
+    
+    sakuc_assert (rbuf_reserve_back(rbuf, sizeof(text), regions) == sizeof(text)
+                  && regions[0].count == sizeof(text) && regions[1].count == 0);
+    memcpy(regions[0].data, text, sizeof(text));
+    sakuc_assert (rbuf_commit_back(rbuf, sizeof(text)) == 0);
+    // the tail of the record landed at the beginning of the buffer.
+    sakuc_assert (memcmp(rbuf->buffer, text + 10, sizeof(text) - 10) == 0);
+    
+    sakuc_assert (rbuf_peek_front(rbuf, 1000, regions) == sizeof(text)
+                  && regions[0].count == sizeof(text) && regions[1].count == 0
+                  && memcmp(regions[0].data, text, sizeof(text)) == 0);
+    sakuc_assert (rbuf_pop_front_n(rbuf, bytes, sizeof(bytes), sizeof(char)) == sizeof(text)
+                  && memcmp(bytes, text, sizeof(text)) == 0);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+#endif
+    
+    // ## test part 14 - readv/writev straight from/to pipes, partial elements.
+    int in_pipe[2], out_pipe[2];
+    sakuc_assert (pipe(in_pipe) == 0 && pipe(out_pipe) == 0);
+    rbuf = rbuf_new_with_policy(10, sizeof(int), RBUF_OVERFLOW_REJECT);
+    sakuc_assert (rbuf);
+    // move to the middle, so that both reads and writes wrap.
+    sakuc_assert (rbuf_reserve_back(rbuf, 6, regions) == 6 && rbuf_commit_back(rbuf, 6) == 0
+                  && rbuf_consume_front(rbuf, 6) == 0);
+    
+    for (int i=0; i < 10; i++)
+        values[i] = 1000 + i;
+    // 2.5 elements first, then the rest and more than the room.
+    sakuc_assert (write(in_pipe[1], values, 2 * sizeof(int) + 2) == 2 * sizeof(int) + 2);
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == 2 * sizeof(int) + 2);
+    sakuc_assert (rbuf_length(rbuf) == 2 && rbuf->partial_in == 2);
+    // the partial element would be overwritten.
+    sakuc_assert (rbuf_push_back(rbuf, values, sizeof(int)) == -1
+                  && rbuf_reserve_back(rbuf, 1, regions) == 0);
+    sakuc_assert (write(in_pipe[1], (char *)values + 2 * sizeof(int) + 2,
+                        8 * sizeof(int) - 2) == 8 * sizeof(int) - 2);
+    sakuc_assert (write(in_pipe[1], values, sizeof(int)) == sizeof(int));
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == 8 * sizeof(int) - 2);  // full now.
+    sakuc_assert (rbuf_length(rbuf) == 10 && rbuf->partial_in == 0);
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == -1);
+    
+    sakuc_assert (rbuf_write_fd(rbuf, out_pipe[1]) == 10 * sizeof(int));
+    sakuc_assert (rbuf_length(rbuf) == 0 && rbuf_write_fd(rbuf, out_pipe[1]) == 0);
+    memset(values, 0, sizeof(values));
+    sakuc_assert (read(out_pipe[0], values, sizeof(values)) == 10 * sizeof(int));
+    for (int i=0; i < 10; i++)
+        sakuc_assert (values[i] == 1000 + i);
+    
+    // end of file.
+    close(in_pipe[1]);
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == sizeof(int) && rbuf_length(rbuf) == 1);
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == 0);
+    close(in_pipe[0]); close(out_pipe[0]); close(out_pipe[1]);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    
+    // ## test part 14.1 - block policy: consumers go on while the reader waits in readv.
+    struct fd_reader reader;
+    pthread_t reader_thread;
+    rbuf = rbuf_new_with_policy(10, sizeof(int), RBUF_OVERFLOW_BLOCK);
+    sakuc_assert (rbuf && pipe(in_pipe) == 0);
+    sakuc_assert (rbuf_push_back(rbuf, &values[0], sizeof(int)) == 0);
+    reader.rb = rbuf;
+    reader.fd = in_pipe[0];
+    sakuc_assert (pthread_create(&reader_thread, nullptr, blocked_read_fd, &reader) == 0);
+    // the back belongs to the reader once it is in readv.
+    while (rbuf_reserve_back(rbuf, 1, regions) > 0)
+        ;
+    sakuc_assert (rbuf_read_fd(rbuf, in_pipe[0]) == -1 && errno == EBUSY);
+    sakuc_assert (rbuf_push_back_timed(rbuf, &values[1], sizeof(int), 0) == -1);
+    sakuc_assert (rbuf_pop_front_timed(rbuf, &value, sizeof(int), 0) && value == values[0]);
+    
+    sakuc_assert (write(in_pipe[1], values, 2 * sizeof(int)) == 2 * sizeof(int));
+    pthread_join(reader_thread, nullptr);
+    sakuc_assert (reader.ret == 2 * sizeof(int) && rbuf_length(rbuf) == 2);
+    sakuc_assert (rbuf_pop_front_n(rbuf, values + 10, 2, sizeof(int)) == 2
+                  && values[10] == values[0] && values[11] == values[1]);
+    close(in_pipe[0]); close(in_pipe[1]);
+    sakuc_assert (rbuf_destroy(rbuf) != -1);
+    
     return 0;
     
 sakuc_assert_failed:
@@ -0,0 +1,131 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "../src/shm_ringbuffer.h"
+#include "common_test_defs.h"
+#include "shm_ringbuffer_test.h"
+
+#define SHM_TEST_COUNT 200000
+
+/* child process: attach by name and produce SHM_TEST_COUNT values. */
+static void shm_test_producer(const char *name)
+{
+    shm_ringbuffer_t *rb = shm_rbuf_attach(name);
+    if (!rb)
+        _exit(1);
+    
+    for (uint32_t i=0; i < SHM_TEST_COUNT; i++) {
+        while (shm_rbuf_push_back(rb, &i, sizeof(i)) == -1)
+            sched_yield();
+    }
+    shm_rbuf_detach(rb);
+    _exit(0);
+}
+
+int test_shm_ringbuffer(void)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "/sakuc_shm_rbuf_test_%ld", (long) getpid());
+    shm_rbuf_unlink(name); // stale one from a crashed run.
+    
+    // ## test part 1 - create by name, attach in the same process, FIFO and full.
+    shm_ringbuffer_t *rb = shm_rbuf_create(name, 1000, sizeof(uint32_t));
+    sakuc_assert(rb && rb->header->capacity == 1024);
+    sakuc_assert(shm_rbuf_create(name, 16, sizeof(uint32_t)) == nullptr); // exists.
+    
+    shm_ringbuffer_t *peer = shm_rbuf_attach(name);
+    sakuc_assert(peer && peer->header != rb->header && peer->block_size == sizeof(uint32_t));
+    
+    uint32_t value;
+    for (uint32_t i=0; i < 1024; i++)
+        sakuc_assert(shm_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(shm_rbuf_push_back(rb, &value, sizeof(value)) == -1);
+    sakuc_assert(shm_rbuf_length(peer) == 1024);
+    
+    for (uint32_t i=0; i < 1024; i++)
+        sakuc_assert(shm_rbuf_pop_front(peer, &value, sizeof(value)) && value == i);
+    sakuc_assert(shm_rbuf_pop_front(peer, &value, sizeof(value)) == nullptr);
+    sakuc_assert(shm_rbuf_detach(peer) != -1);
+    
+    // ## test part 2 - producer in a child process, consumer here.
+    sakuc_assert(shm_rbuf_detach(rb) != -1);
+    rb = shm_rbuf_attach(name);
+    sakuc_assert(rb && shm_rbuf_length(rb) == 0);
+    
+    pid_t pid = fork();
+    sakuc_assert(pid >= 0);
+    if (pid == 0)
+        shm_test_producer(name);
+    
+    uint32_t expected = 0;
+    int status = 0, exited = FALSE;
+    while (expected < SHM_TEST_COUNT) {
+        if (shm_rbuf_pop_front(rb, &value, sizeof(value)) == nullptr) {
+            // the producer gave up (e.g. failed to attach), nothing more will come.
+            if (waitpid(pid, &status, WNOHANG) == pid) {
+                exited = TRUE;
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+        if (value != expected)
+            break;
+        ++expected;
+    }
+    // stopped early: the producer may be stuck on the full ring, don't wait for it.
+    if (!exited && expected < SHM_TEST_COUNT)
+        kill(pid, SIGKILL);
+    sakuc_assert(exited || waitpid(pid, &status, 0) == pid);
+    sakuc_assert(expected == SHM_TEST_COUNT);
+    sakuc_assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    sakuc_assert(shm_rbuf_detach(rb) != -1);
+    sakuc_assert(shm_rbuf_unlink(name) != -1);
+    sakuc_assert(shm_rbuf_attach(name) == nullptr);
+    
+    // ## test part 3 - segments not (yet) initialized are refused.
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    sakuc_assert(fd >= 0);
+    sakuc_assert(shm_rbuf_attach(name) == nullptr);  // empty.
+    sakuc_assert(ftruncate(fd, sizeof(struct shm_rbuf_header) + 64) == 0);
+    sakuc_assert(shm_rbuf_attach(name) == nullptr);  // @ready is 0.
+    close(fd);
+    sakuc_assert(shm_rbuf_unlink(name) != -1);
+    
+    // ## test part 4 - anonymous memfd segment, shared by fd.
+    rb = shm_rbuf_create(nullptr, 8, 16);
+    sakuc_assert(rb);
+    peer = shm_rbuf_attach_fd(dup(shm_rbuf_fd(rb)));
+    sakuc_assert(peer && peer->mask == 7 && peer->block_size == 16);
+    sakuc_assert(peer->segment_size == rb->header->segment_size);
+    
+    char block[16] = "hello, shm";
+    char out[16];
+    sakuc_assert(shm_rbuf_push_back(rb, block, sizeof(block)) == 0);
+    sakuc_assert(shm_rbuf_push_back(rb, block, 8) == -1);
+    sakuc_assert(shm_rbuf_pop_front(peer, out, sizeof(out)) == out && out[7] == 's');
+    
+    // a corrupted header: refused by new attachments, ignored by the attached ones.
+    rb->header->capacity = 1u << 20;
+    rb->header->data_offset = 0;
+    rb->header->segment_size = 1;
+    fd = dup(shm_rbuf_fd(rb));
+    sakuc_assert(shm_rbuf_attach_fd(fd) == nullptr);
+    close(fd);
+    sakuc_assert(shm_rbuf_push_back(rb, block, sizeof(block)) == 0);
+    sakuc_assert(shm_rbuf_pop_front(peer, out, sizeof(out)) == out && out[7] == 's');
+    sakuc_assert(shm_rbuf_detach(peer) != -1);
+    sakuc_assert(shm_rbuf_detach(rb) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef SHM_RINGBUFFER_TEST_H_
+#define SHM_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_shm_ringbuffer(void);
+
+#endif // SHM_RINGBUFFER_TEST_H_
@@ -0,0 +1,100 @@
+#include "../src/sliding_window.h"
+#include "common_test_defs.h"
+#include "sliding_window_test.h"
+
+#define NUM_SAMPLES 20000
+
+static double samples[NUM_SAMPLES];
+
+/* min / max of samples[from, to) by rescanning them. */
+static void naive_min_max(size_t from, size_t to, double *min, double *max)
+{
+    *min = *max = samples[from];
+    for (size_t i = from + 1; i < to; i++) {
+        if (samples[i] < *min)
+            *min = samples[i];
+        if (samples[i] > *max)
+            *max = samples[i];
+    }
+}
+
+/* every window of @sw against the naive rescan, @count samples pushed. */
+static int check_windows(sliding_window_t *sw, const size_t *lengths, size_t num_windows,
+                         size_t count)
+{
+    for (size_t w = 0; w < num_windows; w++) {
+        double min, max, expected_min, expected_max;
+        naive_min_max(count > lengths[w] ? count - lengths[w] : 0, count,
+                      &expected_min, &expected_max);
+        if (swin_min(sw, w, &min) == -1 || swin_max(sw, w, &max) == -1
+            || min != expected_min || max != expected_max)
+            return -1;
+    }
+    return 0;
+}
+
+int test_sliding_window(void)
+{
+    static const size_t lengths[] = { 1, 7, 100, 1000, 4096 };
+    size_t num_windows = sizeof(lengths) / sizeof(lengths[0]);
+    sliding_window_t *sw;
+    double value;
+    
+    // small integers (many ties) in a slow random walk, then a long monotonic run.
+    uint64_t x = 88172645463325252ull;
+    for (size_t i = 0; i < NUM_SAMPLES; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        samples[i] = (double) (x % 64) + (double) (i / 500);
+    }
+    for (size_t i = 15000; i < 17000; i++)
+        samples[i] = (double) i;
+    
+    // ============================== part 1 ==============================
+    // ## test part 1.1 - invalid parameters, no sample yet.
+    size_t zero = 0;
+    sakuc_assert(swin_new(lengths, 0) == nullptr && swin_new(&zero, 1) == nullptr);
+    sakuc_assert((sw = swin_new(lengths, num_windows)) != nullptr);
+    sakuc_assert(swin_min(sw, 0, &value) == -1 && swin_max(sw, 0, &value) == -1);
+    
+    // ## test part 1.2 - one by one, every window checked at every sample.
+    for (size_t i = 0; i < NUM_SAMPLES; i++) {
+        sakuc_assert(swin_push(sw, samples[i]) == 0);
+        if (i < 5000 || i % 97 == 0 || (i >= 14990 && i < 17100))
+            sakuc_assert(check_windows(sw, lengths, num_windows, i + 1) == 0);
+    }
+    sakuc_assert(swin_count(sw) == NUM_SAMPLES);
+    sakuc_assert(swin_min(sw, num_windows, &value) == -1);
+    sakuc_assert(swin_destroy(sw) == 0);
+    
+    // ============================== part 2 ==============================
+    // ## test part 2.1 - batches of various sizes, mixed with single samples, give the
+    // same results.
+    static const size_t batches[] = { 1, 3, 255, 256, 257, 1000, 5000 };
+    sakuc_assert((sw = swin_new(lengths, num_windows)) != nullptr);
+    size_t count = 0;
+    for (size_t b = 0; count < NUM_SAMPLES; b++) {
+        size_t n = batches[b % (sizeof(batches) / sizeof(batches[0]))];
+        if (n > NUM_SAMPLES - count)
+            n = NUM_SAMPLES - count;
+        if (b % 3 == 2) {
+            for (size_t i = 0; i < n; i++)
+                sakuc_assert(swin_push(sw, samples[count + i]) == 0);
+        }
+        else
+            sakuc_assert(swin_push_n(sw, samples + count, n) == 0);
+        count += n;
+        sakuc_assert(check_windows(sw, lengths, num_windows, count) == 0);
+    }
+    sakuc_assert(swin_destroy(sw) == 0);
+    
+    // ## test part 2.3 - a batch longer than every window.
+    sakuc_assert((sw = swin_new(lengths + 2, 2)) != nullptr);
+    sakuc_assert(swin_push_n(sw, samples, NUM_SAMPLES) == 0 && swin_count(sw) == NUM_SAMPLES);
+    sakuc_assert(check_windows(sw, lengths + 2, 2, NUM_SAMPLES) == 0);
+    sakuc_assert(swin_push_n(sw, samples, 0) == 0 && swin_push_n(sw, nullptr, 1) == -1);
+    sakuc_assert(swin_destroy(sw) == 0);
+    
+    return 0;
+sakuc_assert_failed:
+    return -1;
+}
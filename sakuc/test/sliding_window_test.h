@@ -0,0 +1,7 @@
+#ifndef SLIDING_WINDOW_TEST_H_
+#define SLIDING_WINDOW_TEST_H_
+
+// return -1 if test failed.
+extern int test_sliding_window(void);
+
+#endif // SLIDING_WINDOW_TEST_H_
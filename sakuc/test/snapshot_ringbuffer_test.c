@@ -0,0 +1,97 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../src/snapshot_ringbuffer.h"
+#include "../src/common_atomic_defs.h"
+#include "common_test_defs.h"
+#include "snapshot_ringbuffer_test.h"
+
+#define NUM_EVENTS 300000
+
+/* large enough to be torn by a concurrent overwrite. */
+struct event {
+    size_t seq;
+    size_t words[7]; // all equal to @seq.
+};
+
+static int producer_done = FALSE;
+
+static void *producer_thread(void *arg)
+{
+    snapshot_ringbuffer_t *rb = arg;
+    struct event ev;
+    for (size_t i=0; i < NUM_EVENTS; i++) {
+        ev.seq = i;
+        for (size_t j=0; j < 7; j++)
+            ev.words[j] = i;
+        snap_rbuf_push_back(rb, &ev, sizeof(ev));
+        if (i % 256 == 0)
+            sched_yield();
+    }
+    osal_atomic_store_release(&producer_done, TRUE);
+    return nullptr;
+}
+
+int test_snapshot_ringbuffer(void)
+{
+    size_t values[16];
+    size_t first;
+    
+    // ## test part 1 - the most recent elements, oldest first.
+    snapshot_ringbuffer_t *rb = snap_rbuf_new(6, sizeof(size_t));
+    sakuc_assert(rb && rb->capacity == 8);
+    sakuc_assert(snap_rbuf_snapshot(rb, values, 4, sizeof(size_t), &first) == 0);
+    
+    for (size_t i=0; i < 3; i++)
+        sakuc_assert(snap_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(snap_rbuf_length(rb) == 3);
+    sakuc_assert(snap_rbuf_snapshot(rb, values, 4, sizeof(size_t), &first) == 3 && first == 0);
+    sakuc_assert(values[0] == 0 && values[2] == 2);
+    
+    // ## test part 2 - the oldest ones overwritten.
+    for (size_t i=3; i < 20; i++)
+        sakuc_assert(snap_rbuf_push_back(rb, &i, sizeof(i)) == 0);
+    sakuc_assert(snap_rbuf_length(rb) == 8);
+    sakuc_assert(snap_rbuf_snapshot(rb, values, 16, sizeof(size_t), &first) == 8 && first == 12);
+    for (size_t i=0; i < 8; i++)
+        sakuc_assert(values[i] == 12 + i);
+    sakuc_assert(snap_rbuf_snapshot(rb, values, 2, sizeof(size_t), &first) == 2 && first == 18);
+    sakuc_assert(values[0] == 18 && values[1] == 19);
+    sakuc_assert(snap_rbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - snapshots while the producer keeps writing, never torn.
+    rb = snap_rbuf_new(64, sizeof(struct event));
+    sakuc_assert(rb);
+    pthread_t producer;
+    pthread_create(&producer, nullptr, producer_thread, rb);
+    
+    static struct event events[32];
+    int consistent = TRUE;
+    size_t snapshots = 0;
+    size_t last_first = 0;
+    while (!osal_atomic_load_acquire(&producer_done)) {
+        size_t n = snap_rbuf_snapshot(rb, events, 32, sizeof(struct event), &first);
+        for (size_t i=0; i < n; i++) {
+            if (events[i].seq != first + i)
+                consistent = FALSE;
+            for (size_t j=0; j < 7; j++)
+                consistent = consistent && events[i].words[j] == events[i].seq;
+        }
+        // history only moves forward.
+        if (n > 0 && first < last_first)
+            consistent = FALSE;
+        if (n > 0)
+            last_first = first;
+        ++ snapshots;
+    }
+    pthread_join(producer, nullptr);
+    sakuc_assert(consistent && snapshots > 0);
+    
+    sakuc_assert(snap_rbuf_snapshot(rb, events, 32, sizeof(struct event), &first) == 32);
+    sakuc_assert(first == NUM_EVENTS - 32 && events[31].seq == NUM_EVENTS - 1);
+    sakuc_assert(snap_rbuf_destroy(rb) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
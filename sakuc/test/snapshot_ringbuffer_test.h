@@ -0,0 +1,7 @@
+#ifndef SNAPSHOT_RINGBUFFER_TEST_H_
+#define SNAPSHOT_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_snapshot_ringbuffer(void);
+
+#endif // SNAPSHOT_RINGBUFFER_TEST_H_
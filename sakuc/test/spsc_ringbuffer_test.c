@@ -0,0 +1,72 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../src/spsc_ringbuffer.h"
+#include "common_test_defs.h"
+#include "spsc_ringbuffer_test.h"
+
+#define NUM_MESSAGES 200000
+
+static void *producer_thread(void *arg)
+{
+    spsc_ringbuffer_t *rb = arg;
+    for (size_t i = 0; i < NUM_MESSAGES; i++) {
+        while (spsc_rbuf_push_back(rb, &i, sizeof(size_t)) == -1)
+            sched_yield();
+    }
+    return nullptr;
+}
+
+int test_spsc_ringbuffer(void)
+{
+    // ## test part 1 - capacity rounded up to power of 2, never overwritten.
+    spsc_ringbuffer_t *rb = spsc_rbuf_new(1000, sizeof(size_t));
+    sakuc_assert(rb && rb->capacity == 1024);
+    
+    size_t i = 0;
+    for (; i < 2000; i++) {
+        if (spsc_rbuf_push_back(rb, &i, sizeof(size_t)) == -1)
+            break;
+    }
+    sakuc_assert(i == 1024 && spsc_rbuf_length(rb) == 1024);
+    
+    // ## test part 2 - FIFO order, empty afterwards.
+    size_t value = 0;
+    size_t count = 0;
+    while (spsc_rbuf_pop_front(rb, &value, sizeof(size_t)) != nullptr) {
+        if (value == count)
+            ++count;
+        else
+            break;
+    }
+    sakuc_assert(count == 1024 && spsc_rbuf_length(rb) == 0);
+    sakuc_assert(spsc_rbuf_push_back(rb, &value, sizeof(char)) == -1);
+    sakuc_assert(spsc_rbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - one producer thread, one consumer thread.
+    rb = spsc_rbuf_new(64, sizeof(size_t));
+    sakuc_assert(rb);
+    
+    pthread_t producer;
+    sakuc_assert(pthread_create(&producer, nullptr, producer_thread, rb) == 0);
+    
+    // keep draining even if out of order, or the producer would never finish.
+    int in_order = TRUE;
+    count = 0;
+    while (count < NUM_MESSAGES) {
+        if (spsc_rbuf_pop_front(rb, &value, sizeof(size_t)) == nullptr) {
+            sched_yield();
+            continue;
+        }
+        if (value != count)
+            in_order = FALSE;
+        ++count;
+    }
+    pthread_join(producer, nullptr);
+    sakuc_assert(in_order && spsc_rbuf_length(rb) == 0);
+    sakuc_assert(spsc_rbuf_destroy(rb) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
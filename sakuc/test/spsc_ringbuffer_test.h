@@ -0,0 +1,7 @@
+#ifndef SPSC_RINGBUFFER_TEST_H_
+#define SPSC_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_spsc_ringbuffer(void);
+
+#endif // SPSC_RINGBUFFER_TEST_H_
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include "../src/timing_wheel.h"
+#include "common_test_defs.h"
+#include "timing_wheel_test.h"
+
+#define NUM_RANDOM_TIMERS 20000
+
+struct test_timer {
+    tw_timer_t timer;
+    timing_wheel_t *tw;
+    uint64_t deadline;  // expected expiry tick.
+    size_t fired;
+    int on_time;
+    uint64_t period;    // reschedule itself if non-zero.
+};
+
+static void on_expire(tw_timer_t *timer, void *arg)
+{
+    struct test_timer *t = arg;
+    if ((void *) timer != (void *) t || t->tw->now != t->deadline)
+        t->on_time = FALSE;
+    ++ t->fired;
+    
+    if (t->period > 0) {
+        t->deadline = t->tw->now + t->period;
+        tw_schedule(t->tw, timer, t->period);
+    }
+}
+
+static void test_timer_init(struct test_timer *t, timing_wheel_t *tw)
+{
+    tw_timer_init(&t->timer, on_expire, t);
+    t->tw = tw;
+    t->deadline = 0;
+    t->fired = 0;
+    t->on_time = TRUE;
+    t->period = 0;
+}
+
+static int test_timer_schedule(struct test_timer *t, uint64_t delay)
+{
+    t->deadline = t->tw->now + delay;
+    return tw_schedule(t->tw, &t->timer, delay);
+}
+
+int test_timing_wheel(void)
+{
+    // ## test part 1 - expiry at the exact tick, across the level boundaries.
+    timing_wheel_t *tw = tw_new(1000);
+    sakuc_assert(tw && tw->now == 1000);
+    
+    static const uint64_t delays[] = { 1, 2, 255, 256, 257, 300, 65535, 65536, 65537, 1000000 };
+    const size_t num_delays = sizeof(delays) / sizeof(delays[0]);
+    struct test_timer timers[sizeof(delays) / sizeof(delays[0])];
+    for (size_t i=0; i < num_delays; i++) {
+        test_timer_init(&timers[i], tw);
+        sakuc_assert(test_timer_schedule(&timers[i], delays[i]) == 0);
+        sakuc_assert(tw_timer_pending(&timers[i].timer));
+    }
+    sakuc_assert(tw_count(tw) == num_delays);
+    
+    sakuc_assert(tw_advance(tw, 1) == 1 && timers[0].fired == 1);
+    sakuc_assert(tw_advance(tw, 999999) == num_delays - 1 && tw_count(tw) == 0);
+    for (size_t i=0; i < num_delays; i++)
+        sakuc_assert(timers[i].fired == 1 && timers[i].on_time
+                     && !tw_timer_pending(&timers[i].timer));
+    
+    // nothing pending, time still moves.
+    sakuc_assert(tw_advance(tw, 12345) == 0 && tw->now == 1000 + 1000000 + 12345);
+    
+    // ## test part 2 - cancel and reschedule.
+    test_timer_schedule(&timers[0], 10);
+    test_timer_schedule(&timers[1], 70000);
+    sakuc_assert(tw_cancel(tw, &timers[0].timer) == 0 && tw_cancel(tw, &timers[0].timer) == -1);
+    sakuc_assert(test_timer_schedule(&timers[1], 5) == 0 && tw_count(tw) == 1);
+    sakuc_assert(tw_advance(tw, 100000) == 1);
+    sakuc_assert(timers[0].fired == 1 && timers[1].fired == 2 && timers[1].on_time);
+    
+    // ## test part 3 - periodic timer rescheduling itself from its callback.
+    test_timer_init(&timers[2], tw);
+    timers[2].period = 100;
+    test_timer_schedule(&timers[2], 100);
+    sakuc_assert(tw_advance(tw, 100 * 1000) == 1000);
+    sakuc_assert(timers[2].fired == 1000 && timers[2].on_time && tw_count(tw) == 1);
+    sakuc_assert(tw_cancel(tw, &timers[2].timer) == 0 && tw_count(tw) == 0);
+    sakuc_assert(tw_destroy(tw) != -1);
+    
+    // ## test part 4 - many random timers, a third of them cancelled.
+    tw = tw_new(0);
+    struct test_timer *many = malloc(NUM_RANDOM_TIMERS * sizeof(struct test_timer));
+    sakuc_assert(tw && many);
+    
+    srand(20140315);
+    for (size_t i=0; i < NUM_RANDOM_TIMERS; i++) {
+        test_timer_init(&many[i], tw);
+        test_timer_schedule(&many[i], 1 + ((uint64_t) rand() * 7919) % 300000);
+        if (i % 64 == 0)
+            tw_advance(tw, rand() % 50);
+    }
+    size_t cancelled = 0;
+    for (size_t i=0; i < NUM_RANDOM_TIMERS; i += 3) {
+        if (tw_cancel(tw, &many[i].timer) == 0)
+            ++ cancelled;
+    }
+    
+    size_t expired = tw_advance(tw, 400000);
+    size_t fired = 0;
+    int on_time = TRUE;
+    for (size_t i=0; i < NUM_RANDOM_TIMERS; i++) {
+        fired += many[i].fired;
+        on_time = on_time && many[i].on_time;
+    }
+    // some timers expired during the schedule loop already, before being cancelled.
+    sakuc_assert(on_time && tw_count(tw) == 0);
+    sakuc_assert(fired + cancelled == NUM_RANDOM_TIMERS && expired <= fired);
+    
+    free(many);
+    sakuc_assert(tw_destroy(tw) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef TIMING_WHEEL_TEST_H_
+#define TIMING_WHEEL_TEST_H_
+
+// return -1 if test failed.
+extern int test_timing_wheel(void);
+
+#endif // TIMING_WHEEL_TEST_H_
@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include "../src/typed_deque.h"
+#include "common_test_defs.h"
+#include "typed_deque_test.h"
+
+struct point {
+    int16_t x; int16_t y;
+    uint32_t id;
+};
+
+SAKUC_DEQUE_DEFINE(u32_deque, uint32_t, 16)
+SAKUC_DEQUE_DEFINE(point_deque, struct point, 5)
+
+int test_typed_deque(void)
+{
+    // ## test part 1 - FIFO across blocks, the map grows at the back.
+    u32_deque_t *dq = u32_deque_new();
+    sakuc_assert(dq);
+    
+    uint32_t value = 0;
+    sakuc_assert(u32_deque_pop_front(dq, &value) == nullptr && u32_deque_pop_back(dq, &value) == nullptr);
+    sakuc_assert(u32_deque_peek_front(dq) == nullptr && u32_deque_peek_back(dq) == nullptr);
+    for (uint32_t i=0; i < 1000; i++)
+        sakuc_assert(u32_deque_push_back(dq, i) == 0);
+    sakuc_assert(u32_deque_length(dq) == 1000 && dq->map_size > 8);
+    sakuc_assert(*u32_deque_at(dq, 500) == 500 && u32_deque_at(dq, 1000) == nullptr);
+    
+    uint32_t count = 0;
+    while (u32_deque_pop_front(dq, &value) != nullptr) {
+        if (value == count)
+            ++count;
+        else
+            break;
+    }
+    sakuc_assert(count == 1000 && u32_deque_length(dq) == 0);
+    
+    // ## test part 2 - LIFO at the front, the map grows (recenters) at the front.
+    for (uint32_t i=0; i < 1000; i++)
+        sakuc_assert(u32_deque_push_front(dq, i) == 0);
+    sakuc_assert(*u32_deque_peek_front(dq) == 999 && *u32_deque_peek_back(dq) == 0);
+    for (uint32_t i=0; i < 1000; i++)
+        sakuc_assert(u32_deque_pop_front(dq, &value) && value == 999 - i);
+    
+    // ## test part 3 - both ends mixed, against a plain array as reference.
+    static uint32_t ref[4096];
+    size_t ref_first = 2048, ref_last = 2048;
+    uint32_t seed = 1;
+    for (uint32_t i=0; i < 20000; i++) {
+        seed = seed * 1103515245 + 12345;
+        switch ((seed >> 16) % 4) {
+        case 0:
+            if (ref_last < 4096) {
+                ref[ref_last++] = i;
+                sakuc_assert(u32_deque_push_back(dq, i) == 0);
+            }
+            break;
+        case 1:
+            if (ref_first > 0) {
+                ref[--ref_first] = i;
+                sakuc_assert(u32_deque_push_front(dq, i) == 0);
+            }
+            break;
+        case 2:
+            if (ref_first < ref_last)
+                sakuc_assert(u32_deque_pop_front(dq, &value) && value == ref[ref_first++]);
+            else
+                sakuc_assert(u32_deque_pop_front(dq, &value) == nullptr);
+            break;
+        default:
+            if (ref_first < ref_last)
+                sakuc_assert(u32_deque_pop_back(dq, &value) && value == ref[--ref_last]);
+            else
+                sakuc_assert(u32_deque_pop_back(dq, &value) == nullptr);
+            break;
+        }
+        sakuc_assert(u32_deque_length(dq) == ref_last - ref_first);
+    }
+    for (size_t i = ref_first; i < ref_last; i++)
+        sakuc_assert(*u32_deque_at(dq, i - ref_first) == ref[i]);
+    sakuc_assert(u32_deque_destroy(dq) != -1);
+    
+    // ## test part 4 - struct elements, block size not a power of 2.
+    point_deque_t *points = point_deque_new();
+    sakuc_assert(points);
+    for (int16_t i=0; i < 12; i++) {
+        struct point p = { .x = i, .y = -i, .id = 100 + i };
+        sakuc_assert(point_deque_push_back(points, p) == 0);
+    }
+    struct point p;
+    sakuc_assert(point_deque_pop_back(points, &p) && p.x == 11 && p.id == 111);
+    sakuc_assert(point_deque_pop_front(points, &p) && p.x == 0 && p.y == 0);
+    sakuc_assert(point_deque_at(points, 4)->id == 105 && point_deque_length(points) == 10);
+    sakuc_assert(point_deque_destroy(points) != -1);
+    
+    return 0;
+
+sakuc_assert_failed:
+    return -1;
+}
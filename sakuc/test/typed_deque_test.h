@@ -0,0 +1,7 @@
+#ifndef TYPED_DEQUE_TEST_H_
+#define TYPED_DEQUE_TEST_H_
+
+// return -1 if test failed.
+extern int test_typed_deque(void);
+
+#endif // TYPED_DEQUE_TEST_H_
@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include "../src/typed_ringbuffer.h"
+#include "common_test_defs.h"
+#include "typed_ringbuffer_test.h"
+
+struct point {
+    int16_t x; int16_t y;
+    uint32_t id;
+};
+
+SAKUC_RINGBUFFER_DEFINE(u32_rbuf, uint32_t)
+SAKUC_RINGBUFFER_DEFINE(point_rbuf, struct point)
+
+int test_typed_ringbuffer(void)
+{
+    // ## test part 1 - capacity rounded up to power of 2, FIFO order.
+    u32_rbuf_t *rb = u32_rbuf_new(1000);
+    sakuc_assert(rb && rb->capacity == 1024);
+    
+    for (uint32_t i=0; i < 1024; i++)
+        u32_rbuf_push_back(rb, i);
+    sakuc_assert(u32_rbuf_length(rb) == 1024);
+    
+    uint32_t value = 0;
+    uint32_t count = 0;
+    while (u32_rbuf_pop_front(rb, &value) != nullptr) {
+        if (value == count)
+            ++count;
+        else
+            break;
+    }
+    sakuc_assert(count == 1024 && u32_rbuf_length(rb) == 0);
+    
+    // ## test part 2 - the oldest ones overwritten when full, like ringbuffer_t.
+    for (uint32_t i=0; i < 3000; i++)
+        u32_rbuf_push_back(rb, i);
+    sakuc_assert(u32_rbuf_length(rb) == 1024);
+    
+    count = 3000 - 1024;
+    while (u32_rbuf_pop_front(rb, &value) != nullptr) {
+        if (value == count)
+            ++count;
+        else
+            break;
+    }
+    sakuc_assert(count == 3000);
+    sakuc_assert(u32_rbuf_destroy(rb) != -1);
+    
+    // ## test part 3 - struct elements.
+    point_rbuf_t *points = point_rbuf_new(3);
+    sakuc_assert(points && points->capacity == 4);
+    
+    for (int16_t i=0; i < 6; i++) {
+        struct point p = { .x = i, .y = -i, .id = 100 + i };
+        point_rbuf_push_back(points, p);
+    }
+    struct point p;
+    sakuc_assert(point_rbuf_pop_front(points, &p) && p.x == 2 && p.y == -2 && p.id == 102);
+    sakuc_assert(point_rbuf_length(points) == 3);
+    sakuc_assert(point_rbuf_destroy(points) != -1);
+    
+    return 0;
+    
+sakuc_assert_failed:
+    return -1;
+}
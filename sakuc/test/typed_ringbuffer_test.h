@@ -0,0 +1,7 @@
+#ifndef TYPED_RINGBUFFER_TEST_H_
+#define TYPED_RINGBUFFER_TEST_H_
+
+// return -1 if test failed.
+extern int test_typed_ringbuffer(void);
+
+#endif // TYPED_RINGBUFFER_TEST_H_
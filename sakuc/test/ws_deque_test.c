@@ -0,0 +1,112 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../src/ws_deque.h"
+#include "../src/common_atomic_defs.h"
+#include "common_test_defs.h"
+#include "ws_deque_test.h"
+
+#define NUM_THIEVES 3
+#define NUM_TASKS 200000
+
+static ws_deque_t *shared_dq = nullptr;
+static int owner_done = FALSE;
+static size_t taken[NUM_TASKS];     // how many times each task was popped or stolen.
+
+static void *thief_thread(void *arg)
+{
+    size_t *num_stolen = arg;
+    for (;;) {
+        size_t *task = ws_deque_steal(shared_dq);
+        if (task) {
+            osal_atomic_fetch_add(&taken[*task], 1);
+            ++ *num_stolen;
+        }
+        else if (osal_atomic_load_acquire(&owner_done) && ws_deque_length(shared_dq) == 0)
+            break;
+        else
+            sched_yield();
+    }
+    return nullptr;
+}
+
+int test_ws_deque(void)
+{
+    static size_t ids[NUM_TASKS];
+    for (size_t i = 0; i < NUM_TASKS; i++)
+        ids[i] = i;
+    
+    // ## test part 1 - owner only: LIFO at the bottom, growing from 2 slots.
+    ws_deque_t *dq = ws_deque_new(0);
+    sakuc_assert(dq && dq->array->size == 2);
+    sakuc_assert(ws_deque_pop_bottom(dq) == nullptr && ws_deque_steal(dq) == nullptr);
+    sakuc_assert(ws_deque_push_bottom(dq, nullptr) == -1);
+    
+    for (size_t i = 0; i < 100; i++)
+        sakuc_assert(ws_deque_push_bottom(dq, &ids[i]) == 0);
+    sakuc_assert(ws_deque_length(dq) == 100 && dq->array->size == 128);
+    for (size_t i = 100; i > 50; i--)
+        sakuc_assert(ws_deque_pop_bottom(dq) == &ids[i - 1]);
+    
+    // ## test part 2 - thieves take the oldest ones (FIFO at the top).
+    for (size_t i = 0; i < 10; i++)
+        sakuc_assert(ws_deque_steal(dq) == &ids[i]);
+    sakuc_assert(ws_deque_length(dq) == 40);
+    
+    // wrap around the circular array, then grow with a non-zero @top.
+    for (size_t i = 100; i < 300; i++)
+        sakuc_assert(ws_deque_push_bottom(dq, &ids[i]) == 0);
+    sakuc_assert(ws_deque_length(dq) == 240 && dq->array->size == 256);
+    for (size_t i = 10; i < 50; i++)
+        sakuc_assert(ws_deque_steal(dq) == &ids[i]);
+    for (size_t i = 300; i > 100; i--)
+        sakuc_assert(ws_deque_pop_bottom(dq) == &ids[i - 1]);
+    sakuc_assert(ws_deque_pop_bottom(dq) == nullptr && ws_deque_length(dq) == 0);
+    sakuc_assert(ws_deque_destroy(dq) != -1);
+    
+    // ## test part 3 - the owner pushes and pops while thieves steal, every task
+    //    is taken exactly once.
+    shared_dq = ws_deque_new(16);
+    sakuc_assert(shared_dq);
+    owner_done = FALSE;
+    for (size_t i = 0; i < NUM_TASKS; i++)
+        taken[i] = 0;
+    
+    pthread_t threads[NUM_THIEVES];
+    size_t num_stolen[NUM_THIEVES] = {0};
+    for (size_t i = 0; i < NUM_THIEVES; i++)
+        sakuc_assert(pthread_create(&threads[i], nullptr, thief_thread, &num_stolen[i]) == 0);
+    
+    size_t num_popped = 0;
+    for (size_t i = 0; i < NUM_TASKS; i++) {
+        sakuc_assert(ws_deque_push_bottom(shared_dq, &ids[i]) == 0);
+        if (i % 3 == 0) {
+            size_t *task = ws_deque_pop_bottom(shared_dq);
+            if (task) {
+                osal_atomic_fetch_add(&taken[*task], 1);
+                ++ num_popped;
+            }
+        }
+    }
+    size_t *task = nullptr;
+    while ((task = ws_deque_pop_bottom(shared_dq)) != nullptr) {
+        osal_atomic_fetch_add(&taken[*task], 1);
+        ++ num_popped;
+    }
+    osal_atomic_store_release(&owner_done, TRUE);
+    for (size_t i = 0; i < NUM_THIEVES; i++)
+        pthread_join(threads[i], nullptr);
+    
+    size_t total = num_popped;
+    for (size_t i = 0; i < NUM_THIEVES; i++)
+        total += num_stolen[i];
+    sakuc_assert(total == NUM_TASKS);
+    for (size_t i = 0; i < NUM_TASKS; i++)
+        sakuc_assert(taken[i] == 1);
+    sakuc_assert(ws_deque_destroy(shared_dq) != -1);
+    shared_dq = nullptr;
+    
+    return 0;
+
+sakuc_assert_failed:
+    return -1;
+}
@@ -0,0 +1,7 @@
+#ifndef WS_DEQUE_TEST_H_
+#define WS_DEQUE_TEST_H_
+
+// return -1 if test failed.
+extern int test_ws_deque(void);
+
+#endif // WS_DEQUE_TEST_H_
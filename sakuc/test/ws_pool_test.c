@@ -0,0 +1,103 @@
+#include "../src/ws_pool.h"
+#include "../src/common_atomic_defs.h"
+#include "common_test_defs.h"
+#include "ws_pool_test.h"
+
+#define NUM_WORKERS 4
+
+/* fork/join fibonacci, one task per call above the cut-off. */
+struct fib_task {
+    struct ws_task task;
+    int n;
+    long result;
+};
+
+static long fib_seq(int n)
+{
+    return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+static void fib_run(struct ws_worker *w, struct ws_task *task)
+{
+    struct fib_task *f = (struct fib_task *) task;
+    if (f->n < 10) {
+        f->result = fib_seq(f->n);
+        return;
+    }
+    
+    struct fib_task left = { .task.run = fib_run, .n = f->n - 1 };
+    struct fib_task right = { .task.run = fib_run, .n = f->n - 2 };
+    struct ws_group group = WS_GROUP_INIT;
+    if (ws_pool_spawn(w, &group, &left.task) == -1)
+        fib_run(w, &left.task);
+    fib_run(w, &right.task);
+    ws_worker_wait(w, &group);
+    f->result = left.result + right.result;
+}
+
+/* independent tasks submitted from outside the pool. */
+struct count_task {
+    struct ws_task task;
+    size_t *counter;
+};
+
+static void count_run(struct ws_worker *w, struct ws_task *task)
+{
+    (void) w;
+    struct count_task *c = (struct count_task *) task;
+    osal_atomic_fetch_add(c->counter, 1);
+}
+
+int test_ws_pool(void)
+{
+    ws_pool_t *pool = nullptr;
+    sakuc_assert(ws_pool_new(0, 16) == nullptr);
+    
+    // ## test part 1 - fork/join from within the tasks.
+    pool = ws_pool_new(NUM_WORKERS, 16);
+    sakuc_assert(pool);
+    
+    struct fib_task root = { .task.run = fib_run, .n = 25 };
+    struct ws_group group = WS_GROUP_INIT;
+    sakuc_assert(ws_pool_submit(pool, &group, &root.task) == 0);
+    ws_pool_wait(pool, &group);
+    sakuc_assert(group.pending == 0 && root.result == 75025);
+    
+    size_t executed = 0;
+    for (size_t i = 0; i < NUM_WORKERS; i++)
+        executed += pool->workers[i].executed;
+    sakuc_assert(executed > 1000); // one task per fib_run() call with n >= 10.
+    
+    // ## test part 2 - many independent tasks, a full inbox is reported.
+    static struct count_task tasks[1000];
+    size_t counter = 0;
+    size_t submitted = 0;
+    for (size_t i = 0; i < 1000; i++) {
+        tasks[i] = (struct count_task) { .task.run = count_run, .counter = &counter };
+        while (ws_pool_submit(pool, &group, &tasks[i].task) == -1)
+            ws_pool_wait(pool, &group);
+        ++ submitted;
+    }
+    ws_pool_wait(pool, &group);
+    sakuc_assert(submitted == 1000 && counter == 1000);
+    
+    struct ws_task no_run = { .run = nullptr };
+    sakuc_assert(ws_pool_submit(pool, nullptr, &no_run) == -1);
+    sakuc_assert(ws_pool_destroy(pool) != -1);
+    
+    // ## test part 3 - a single worker runs everything itself.
+    pool = ws_pool_new(1, 4);
+    sakuc_assert(pool);
+    root = (struct fib_task) { .task.run = fib_run, .n = 20 };
+    sakuc_assert(ws_pool_submit(pool, &group, &root.task) == 0);
+    ws_pool_wait(pool, &group);
+    sakuc_assert(root.result == 6765 && pool->workers[0].steals == 0);
+    sakuc_assert(ws_pool_destroy(pool) != -1);
+    
+    return 0;
+
+sakuc_assert_failed:
+    if (pool)
+        ws_pool_destroy(pool);
+    return -1;
+}
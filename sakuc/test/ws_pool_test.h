@@ -0,0 +1,7 @@
+#ifndef WS_POOL_TEST_H_
+#define WS_POOL_TEST_H_
+
+// return -1 if test failed.
+extern int test_ws_pool(void);
+
+#endif // WS_POOL_TEST_H_